@@ -350,8 +350,14 @@ struct bfd_hash_table
   unsigned int count;
   /* The size of elements.  */
   unsigned int entsize;
+  /* The number of slots freed by bfd_hash_rename in an open addressed
+     table.  */
+  unsigned int deleted;
   /* If non-zero, don't grow the hash table.  */
   unsigned int frozen:1;
+  /* If non-zero, the table uses open addressing: each slot of TABLE
+     holds at most one entry, and SIZE is a power of two.  */
+  unsigned int open_addressing:1;
 };
 
 /* Initialize a hash table.  */
@@ -370,6 +376,10 @@ extern bfd_boolean bfd_hash_table_init_n
 			       const char *),
    unsigned int, unsigned int);
 
+/* Make an empty hash table use open addressing.  */
+extern bfd_boolean bfd_hash_table_open_addressing
+  (struct bfd_hash_table *);
+
 /* Free up a hash table.  */
 extern void bfd_hash_table_free
   (struct bfd_hash_table *);
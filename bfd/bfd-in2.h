@@ -357,8 +357,14 @@ struct bfd_hash_table
   unsigned int count;
   /* The size of elements.  */
   unsigned int entsize;
+  /* The number of slots freed by bfd_hash_rename in an open addressed
+     table.  */
+  unsigned int deleted;
   /* If non-zero, don't grow the hash table.  */
   unsigned int frozen:1;
+  /* If non-zero, the table uses open addressing: each slot of TABLE
+     holds at most one entry, and SIZE is a power of two.  */
+  unsigned int open_addressing:1;
 };
 
 /* Initialize a hash table.  */
@@ -377,6 +383,10 @@ extern bfd_boolean bfd_hash_table_init_n
 			       const char *),
    unsigned int, unsigned int);
 
+/* Make an empty hash table use open addressing.  */
+extern bfd_boolean bfd_hash_table_open_addressing
+  (struct bfd_hash_table *);
+
 /* Free up a hash table.  */
 extern void bfd_hash_table_free
   (struct bfd_hash_table *);
@@ -771,6 +781,13 @@ bfd_vma bfd_getl24 (const void *p);
 #define H_GET_S16 bfd_h_get_signed_16
 #define H_GET_S8  bfd_h_get_signed_8
 
+void bfd_set_max_threads (unsigned int count);
+
+unsigned int bfd_get_max_threads (void);
+
+void bfd_parallel_for
+   (size_t count, void (*func) (void *, size_t), void *data);
+
 
 /* Extracted from bfdio.c.  */
 long bfd_get_mtime (bfd *abfd);
@@ -6613,17 +6630,22 @@ struct bfd
   /* Put pathnames into archives (non-POSIX).  */
 #define BFD_ARCHIVE_FULL_PATH  0x100000
 
+  /* Map section contents read with bfd_get_full_section_contents_view
+     from the file, rather than copying them, where possible.  */
+#define BFD_MMAP_CONTENTS      0x200000
+
   /* Flags bits to be saved in bfd_preserve_save.  */
 #define BFD_FLAGS_SAVED \
   (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_LINKER_CREATED \
    | BFD_PLUGIN | BFD_COMPRESS_GABI | BFD_CONVERT_ELF_COMMON \
-   | BFD_USE_ELF_STT_COMMON)
+   | BFD_USE_ELF_STT_COMMON | BFD_MMAP_CONTENTS)
 
   /* Flags bits which are for BFD use only.  */
 #define BFD_FLAGS_FOR_BFD_USE_MASK \
   (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_LINKER_CREATED \
    | BFD_PLUGIN | BFD_TRADITIONAL_FORMAT | BFD_DETERMINISTIC_OUTPUT \
-   | BFD_COMPRESS_GABI | BFD_CONVERT_ELF_COMMON | BFD_USE_ELF_STT_COMMON)
+   | BFD_COMPRESS_GABI | BFD_CONVERT_ELF_COMMON | BFD_USE_ELF_STT_COMMON \
+   | BFD_MMAP_CONTENTS)
 
   /* The format which belongs to the BFD. (object, core, etc.)  */
   ENUM_BITFIELD (bfd_format) format : 3;
@@ -7887,6 +7909,9 @@ bfd_byte *bfd_simple_get_relocated_section_contents
 bfd_boolean bfd_get_full_section_contents
    (bfd *abfd, asection *section, bfd_byte **ptr);
 
+bfd_boolean bfd_get_full_section_contents_view
+   (bfd *abfd, asection *section, bfd_window *view);
+
 void bfd_cache_section_contents
    (asection *sec, void *contents);
 
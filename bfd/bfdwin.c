@@ -24,10 +24,9 @@
 #include "bfd.h"
 #include "libbfd.h"
 
-/* Currently, if USE_MMAP is undefined, none of the window stuff is
-   used.  Enabled by --with-mmap.  */
-
-#ifdef USE_MMAP
+/* Windows are used to read parts of a.out files when USE_MMAP is
+   defined, which is enabled by --with-mmap, and by
+   bfd_get_full_section_contents_view.  */
 
 #undef HAVE_MPROTECT /* code's not tested yet */
 
@@ -261,5 +260,3 @@ bfd_get_file_window (bfd *abfd,
   free (i);
   return FALSE;
 }
-
-#endif /* USE_MMAP */
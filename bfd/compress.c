@@ -23,6 +23,9 @@
 #include "bfd.h"
 #include "libbfd.h"
 #include "safe-ctype.h"
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 
 #define MAX_COMPRESSION_HEADER_SIZE 24
 
@@ -361,6 +364,119 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
     }
 }
 
+/*
+FUNCTION
+	bfd_get_full_section_contents_view
+
+SYNOPSIS
+	bfd_boolean bfd_get_full_section_contents_view
+	  (bfd *abfd, asection *section, bfd_window *view);
+
+DESCRIPTION
+	Set @var{view}, which must have been initialized with
+	<<bfd_init_window>>, to all data from @var{section} in BFD
+	@var{abfd}, decompressed if needed.  If @var{abfd} has the
+	<<BFD_MMAP_CONTENTS>> flag set and the section is stored
+	uncompressed in a file, the view maps the file rather than
+	copying it, and stays valid after @var{abfd} is closed.
+	Otherwise the data is read into memory malloc'd by this
+	function.  The data must not be modified.  Release it with
+	<<bfd_free_window>>.
+
+	Return @code{TRUE} if the full section contents is retrieved
+	successfully.  If the section has no contents then this function
+	returns @code{TRUE} but the data of @var{view} is NULL.
+*/
+
+bfd_boolean
+bfd_get_full_section_contents_view (bfd *abfd, sec_ptr sec,
+				    bfd_window *view)
+{
+  bfd_window_internal *i;
+  bfd_size_type sz;
+  bfd_byte *p;
+
+  bfd_free_window (view);
+  view->size = 0;
+
+  if (abfd->direction != write_direction && sec->rawsize != 0)
+    sz = sec->rawsize;
+  else
+    sz = sec->size;
+  if (sz == 0)
+    return TRUE;
+
+  i = (bfd_window_internal *) bfd_zmalloc (sizeof (*i));
+  if (i == NULL)
+    return FALSE;
+  i->refcount = 1;
+
+#ifdef HAVE_MMAP
+  if ((abfd->flags & (BFD_MMAP_CONTENTS | BFD_IN_MEMORY)) == BFD_MMAP_CONTENTS
+      && sec->compress_status == COMPRESS_SECTION_NONE
+      && ((sec->flags & (SEC_HAS_CONTENTS | SEC_IN_MEMORY | SEC_CONSTRUCTOR))
+	  == SEC_HAS_CONTENTS)
+      && (abfd->xvec->_bfd_get_section_contents
+	  == _bfd_generic_get_section_contents)
+      && sec->filepos >= 0)
+    {
+      bfd *file = abfd;
+      ufile_ptr end = sec->filepos + sz;
+
+      /* Mapping pages beyond the end of the file would fault when
+	 they are read, so check that the file really holds the
+	 section.  */
+      if (end >= sz
+	  && (abfd->my_archive == NULL
+	      || bfd_is_thin_archive (abfd->my_archive)
+	      || end <= arelt_size (abfd)))
+	{
+	  while (file->my_archive != NULL
+		 && !bfd_is_thin_archive (file->my_archive))
+	    {
+	      end += file->origin;
+	      file = file->my_archive;
+	    }
+	  end += file->origin;
+	  if (end <= bfd_get_size (file))
+	    {
+	      void *map_addr;
+	      bfd_size_type map_len;
+
+	      p = (bfd_byte *) bfd_mmap (abfd, NULL, sz, PROT_READ,
+					 MAP_PRIVATE, sec->filepos,
+					 &map_addr, &map_len);
+	      if (p != (bfd_byte *) -1)
+		{
+		  i->data = map_addr;
+		  i->size = map_len;
+		  i->mapped = 1;
+		  view->data = p;
+		  view->size = sz;
+		  view->i = i;
+		  return TRUE;
+		}
+	    }
+	}
+    }
+#endif
+
+  /* Fall back to reading a copy.  */
+  p = NULL;
+  if (!bfd_get_full_section_contents (abfd, sec, &p))
+    {
+      free (i);
+      return FALSE;
+    }
+  i->data = p;
+  i->size = sz;
+  i->mapped = 0;
+  view->data = p;
+  view->size = sz;
+  view->i = i;
+  return TRUE;
+}
+
 /*
 FUNCTION
 	bfd_cache_section_contents
@@ -647,3 +763,137 @@ bfd_compress_section (bfd *abfd, sec_ptr sec, bfd_byte *uncompressed_buffer)
   return bfd_compress_section_contents (abfd, sec, uncompressed_buffer,
 					uncompressed_size) != 0;
 }
+
+/* The zlib compression of one section by _bfd_compress_sections.  */
+
+struct compress_job
+{
+  const bfd_byte *in;
+  bfd_size_type in_size;
+  bfd_byte *out;
+  uLong out_size;
+  int status;
+};
+
+static void
+compress_job_run (void *data, size_t i)
+{
+  struct compress_job *job = (struct compress_job *) data + i;
+
+  if (job->out != NULL)
+    job->status = compress ((Bytef *) job->out, &job->out_size,
+			    (const Bytef *) job->in, job->in_size);
+}
+
+/* Compress the COUNT sections in SECS of ABFD, whose uncompressed
+   contents are in BUFFERS, as bfd_compress_section would do one at a
+   time.  The zlib compression of sections that aren't compressed
+   already is spread over the threads allowed by bfd_set_max_threads;
+   everything else happens in the calling thread.  */
+
+bfd_boolean
+_bfd_compress_sections (bfd *abfd, unsigned int count, asection **secs,
+			bfd_byte **buffers)
+{
+  struct compress_job *jobs;
+  int header_size;
+  bfd_boolean ret = TRUE;
+  unsigned int i;
+
+  if (count < 2 || bfd_get_max_threads () < 2)
+    {
+      for (i = 0; i < count; i++)
+	if (!bfd_compress_section (abfd, secs[i], buffers[i]))
+	  return FALSE;
+      return TRUE;
+    }
+
+  jobs = (struct compress_job *) bfd_zmalloc (count * sizeof (*jobs));
+  if (jobs == NULL)
+    return FALSE;
+
+  /* Either ELF compression header or the 12-byte, "ZLIB" + 8-byte size,
+     overhead in .zdebug* section.  */
+  header_size = bfd_get_compression_header_size (abfd, NULL);
+  if (!header_size)
+    header_size = 12;
+
+  /* Sections that are compressed already, or that we have no memory
+     for, are left to bfd_compress_section below.  */
+  for (i = 0; i < count; i++)
+    {
+      asection *sec = secs[i];
+      int orig_header_size;
+      bfd_size_type orig_size;
+      unsigned int orig_alignment_pow;
+
+      if (abfd->direction != write_direction
+	  || sec->size == 0
+	  || buffers[i] == NULL
+	  || sec->contents != NULL
+	  || sec->compressed_size != 0
+	  || sec->compress_status != COMPRESS_SECTION_NONE
+	  || bfd_is_section_compressed_with_header (abfd, sec,
+						    &orig_header_size,
+						    &orig_size,
+						    &orig_alignment_pow))
+	continue;
+
+      jobs[i].in = buffers[i];
+      jobs[i].in_size = sec->size;
+      jobs[i].out_size = compressBound (sec->size);
+      jobs[i].out = (bfd_byte *) bfd_malloc (jobs[i].out_size);
+    }
+
+  bfd_parallel_for (count, compress_job_run, jobs);
+
+  for (i = 0; i < count; i++)
+    {
+      asection *sec = secs[i];
+      struct compress_job *job = &jobs[i];
+      bfd_size_type compressed_size;
+      bfd_byte *buffer;
+
+      if (ret)
+	{
+	  if (job->out == NULL)
+	    ret = bfd_compress_section (abfd, sec, buffers[i]);
+	  else if (job->status != Z_OK)
+	    {
+	      bfd_set_error (bfd_error_bad_value);
+	      ret = FALSE;
+	    }
+	  else
+	    {
+	      compressed_size = job->out_size + header_size;
+
+	      /* PR binutils/18087: If compression didn't make the section
+		 smaller, just keep it uncompressed.  */
+	      if (compressed_size < sec->size)
+		{
+		  buffer = (bfd_byte *) bfd_alloc (abfd, compressed_size);
+		  if (buffer == NULL)
+		    ret = FALSE;
+		  else
+		    {
+		      memcpy (buffer + header_size, job->out, job->out_size);
+		      bfd_update_compression_header (abfd, buffer, sec);
+		      free (buffers[i]);
+		      sec->contents = buffer;
+		      sec->size = compressed_size;
+		      sec->compress_status = COMPRESS_SECTION_DONE;
+		    }
+		}
+	      else
+		{
+		  sec->contents = buffers[i];
+		  sec->compress_status = COMPRESS_SECTION_NONE;
+		}
+	    }
+	}
+      free (job->out);
+    }
+
+  free (jobs);
+  return ret;
+}
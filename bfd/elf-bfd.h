@@ -1163,6 +1163,20 @@ struct elf_backend_data
      asection *input_section, bfd_byte *contents, Elf_Internal_Rela *relocs,
      Elf_Internal_Sym *local_syms, asection **local_sections);
 
+  /* This function, if defined, is called in a final link with --threads
+     before INPUT_SECTION is relocated, with the arguments that
+     RELOCATE_SECTION will get.  It returns TRUE if RELOCATE_SECTION may
+     be run on the section in a worker thread, concurrently with other
+     such sections, and after the link has moved on to later input
+     sections.  That is the case if, for these relocs, RELOCATE_SECTION
+     only reads link state that is final by now, writes nothing but
+     CONTENTS and RELOCS, reports problems only through INFO's
+     callbacks or _bfd_error_handler, and never returns 2.  */
+  bfd_boolean (*elf_backend_can_relocate_in_parallel)
+    (struct bfd_link_info *info, bfd *input_bfd, asection *input_section,
+     Elf_Internal_Rela *relocs, Elf_Internal_Sym *local_syms,
+     asection **local_sections);
+
   /* The FINISH_DYNAMIC_SYMBOL function is called by the ELF backend
      linker just before it writes a symbol out to the .dynsym section.
      The processor backend may make any required adjustment to the
@@ -1979,6 +1993,11 @@ struct elf_obj_tdata
   /* Symbol buffer.  */
   void *symbuf;
 
+  /* Global symbols swapped in ahead of elf_link_add_object_symbols by
+     bfd_elf_link_prefetch_symbols, and how many there are.  */
+  Elf_Internal_Sym *prefetched_syms;
+  size_t prefetched_symcount;
+
   /* List of GNU properties.  Will be updated by setup_gnu_properties
      after all input GNU properties are merged for output.  */
   elf_property_list *properties;
@@ -2557,6 +2576,8 @@ extern struct elf_link_hash_entry *_bfd_elf_archive_symbol_lookup
   (bfd *, struct bfd_link_info *, const char *);
 extern bfd_boolean bfd_elf_link_add_symbols
   (bfd *, struct bfd_link_info *);
+extern void bfd_elf_link_prefetch_symbols
+  (bfd **, size_t);
 extern bfd_boolean _bfd_elf_add_dynamic_entry
   (struct bfd_link_info *, bfd_vma, bfd_vma);
 extern bfd_boolean _bfd_elf_strip_zero_sized_dynamic_sections
@@ -584,7 +584,8 @@ _bfd_elf_parse_eh_frame (bfd *abfd, struct bfd_link_info *info,
       goto free_no_table;				\
   while (0)
 
-  bfd_byte *ehbuf = NULL, *buf, *end;
+  bfd_window ehview;
+  bfd_byte *ehbuf, *buf, *end;
   bfd_byte *last_fde;
   struct eh_cie_fde *this_inf;
   unsigned int hdr_length, hdr_id;
@@ -617,7 +618,9 @@ _bfd_elf_parse_eh_frame (bfd *abfd, struct bfd_link_info *info,
 
   /* Read the frame unwind information from abfd.  */
 
-  REQUIRE (bfd_malloc_and_get_section (abfd, sec, &ehbuf));
+  bfd_init_window (&ehview);
+  REQUIRE (bfd_get_full_section_contents_view (abfd, sec, &ehview));
+  ehbuf = (bfd_byte *) ehview.data;
 
   /* If .eh_frame section size doesn't fit into int, we cannot handle
      it (it would need to use 64-bit .eh_frame format anyway).  */
@@ -1051,7 +1054,7 @@ _bfd_elf_parse_eh_frame (bfd *abfd, struct bfd_link_info *info,
   hdr_info->u.dwarf.table = FALSE;
   free (sec_info);
  success:
-  free (ehbuf);
+  bfd_free_window (&ehview);
   free (local_cies);
 #undef REQUIRE
 }
@@ -107,6 +107,8 @@ _bfd_elf_strtab_init (void)
       free (table);
       return NULL;
     }
+  /* The chained table is kept if open addressing can't be set up.  */
+  bfd_hash_table_open_addressing (&table->table);
 
   table->sec_size = 0;
   table->size = 1;
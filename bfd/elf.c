@@ -6537,6 +6537,55 @@ _bfd_elf_modify_headers (bfd *obfd, struct bfd_link_info *link_info)
   return TRUE;
 }
 
+/* Compress the DWARF debug sections of ABFD that have yet to be given
+   a file position.  They are all handed to _bfd_compress_sections at
+   once so that they can be compressed in parallel.  */
+
+static bfd_boolean
+elf_compress_debug_sections (bfd *abfd)
+{
+  Elf_Internal_Shdr **shdrpp, **end_shdrpp;
+  asection **secs;
+  bfd_byte **buffers;
+  unsigned int count = 0;
+  bfd_boolean ret;
+
+  shdrpp = elf_elfsections (abfd);
+  end_shdrpp = shdrpp + elf_numsections (abfd);
+  secs = (asection **) bfd_malloc (elf_numsections (abfd) * sizeof (*secs));
+  buffers = (bfd_byte **) bfd_malloc (elf_numsections (abfd)
+				      * sizeof (*buffers));
+  if (secs == NULL || buffers == NULL)
+    {
+      free (secs);
+      free (buffers);
+      return FALSE;
+    }
+
+  for (shdrpp++; shdrpp < end_shdrpp; shdrpp++)
+    {
+      Elf_Internal_Shdr *shdrp = *shdrpp;
+      asection *sec = shdrp->bfd_section;
+
+      if (shdrp->sh_offset == -1
+	  && shdrp->sh_type != SHT_REL
+	  && shdrp->sh_type != SHT_RELA
+	  && sec != NULL
+	  && !bfd_section_is_ctf (sec)
+	  && (sec->flags & SEC_ELF_COMPRESS) != 0)
+	{
+	  secs[count] = sec;
+	  buffers[count] = shdrp->contents;
+	  count++;
+	}
+    }
+
+  ret = _bfd_compress_sections (abfd, count, secs, buffers);
+  free (secs);
+  free (buffers);
+  return ret;
+}
+
 /* Assign file positions for all the reloc sections which are not part
    of the loadable file image, and the file position of section headers.  */
 
@@ -6551,6 +6600,9 @@ _bfd_elf_assign_file_positions_for_non_load (bfd *abfd)
 
   off = elf_next_file_pos (abfd);
 
+  if (!elf_compress_debug_sections (abfd))
+    return FALSE;
+
   shdrpp = elf_elfsections (abfd);
   end_shdrpp = shdrpp + elf_numsections (abfd);
   for (shdrpp++; shdrpp < end_shdrpp; shdrpp++)
@@ -6571,11 +6623,6 @@ _bfd_elf_assign_file_positions_for_non_load (bfd *abfd)
 		  const char *name = sec->name;
 		  struct bfd_elf_section_data *d;
 
-		  /* Compress DWARF debug sections.  */
-		  if (!bfd_compress_section (abfd, sec,
-					     shdrp->contents))
-		    return FALSE;
-
 		  if (sec->compress_status == COMPRESS_SECTION_DONE
 		      && (abfd->flags & BFD_COMPRESS_GABI) == 0)
 		    {
@@ -9445,6 +9492,7 @@ _bfd_elf_close_and_cleanup (bfd *abfd)
       if (elf_tdata (abfd)->o != NULL && elf_shstrtab (abfd) != NULL)
 	_bfd_elf_strtab_free (elf_shstrtab (abfd));
       _bfd_dwarf2_cleanup_debug_info (abfd, &tdata->dwarf2_find_line_info);
+      free (tdata->prefetched_syms);
     }
 
   return _bfd_generic_close_and_cleanup (abfd);
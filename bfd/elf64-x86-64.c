@@ -4144,6 +4144,74 @@ elf_x86_64_relocate_section (bfd *output_bfd,
   return TRUE;
 }
 
+/* Return TRUE if elf_x86_64_relocate_section may relocate INPUT_SECTION
+   in a worker thread.  That is so for the plain data relocations of
+   debugging sections in a final link, which only change the section
+   contents.  */
+
+static bfd_boolean
+elf_x86_64_can_relocate_in_parallel (struct bfd_link_info *info,
+				     bfd *input_bfd,
+				     asection *input_section,
+				     Elf_Internal_Rela *relocs,
+				     Elf_Internal_Sym *local_syms,
+				     asection **local_sections)
+{
+  struct elf_x86_link_hash_table *htab;
+  Elf_Internal_Shdr *symtab_hdr;
+  Elf_Internal_Rela *rel, *relend;
+
+  htab = elf_x86_hash_table (info, X86_64_ELF_DATA);
+  if (htab == NULL
+      || !is_x86_elf (input_bfd, htab)
+      || bfd_link_relocatable (info)
+      || info->wrap_hash != NULL
+      || (input_section->flags & SEC_ALLOC) != 0
+      || input_section->check_relocs_failed)
+    return FALSE;
+
+  /* Set the value of _TLS_MODULE_BASE_ now, so that the calls made by
+     elf_x86_64_relocate_section in worker threads find nothing to
+     change.  */
+  _bfd_x86_elf_set_tls_module_base (info);
+
+  symtab_hdr = &elf_symtab_hdr (input_bfd);
+  relend = relocs + input_section->reloc_count;
+  for (rel = relocs; rel < relend; rel++)
+    {
+      unsigned long r_symndx = htab->r_sym (rel->r_info);
+      asection *sec;
+
+      switch (ELF32_R_TYPE (rel->r_info))
+	{
+	case R_X86_64_NONE:
+	case R_X86_64_32:
+	case R_X86_64_64:
+	case R_X86_64_DTPOFF32:
+	case R_X86_64_DTPOFF64:
+	  break;
+
+	default:
+	  return FALSE;
+	}
+
+      if (r_symndx >= symtab_hdr->sh_info)
+	continue;
+
+      /* Relocating against a local STT_GNU_IFUNC symbol sets its hash
+	 table entry, and _bfd_elf_rela_local_sym notes where the
+	 strings of a SEC_MERGE section that was merged away went.  */
+      sec = local_sections[r_symndx];
+      if (ELF_ST_TYPE (local_syms[r_symndx].st_info) == STT_GNU_IFUNC
+	  || sec == NULL
+	  || ((sec->flags & (SEC_MERGE | SEC_EXCLUDE))
+	      == (SEC_MERGE | SEC_EXCLUDE)))
+	return FALSE;
+    }
+
+  return TRUE;
+}
+
 /* Finish up dynamic symbol handling.  We set the contents of various
    dynamic sections here.  */
 
@@ -5251,6 +5319,8 @@ elf_x86_64_special_sections[]=
 #endif
 #define elf_backend_reloc_type_class	    elf_x86_64_reloc_type_class
 #define elf_backend_relocate_section	    elf_x86_64_relocate_section
+#define elf_backend_can_relocate_in_parallel \
+	elf_x86_64_can_relocate_in_parallel
 #define elf_backend_init_index_section	    _bfd_elf_init_1_index_section
 #define elf_backend_object_p		    elf64_x86_64_elf_object_p
 #define bfd_elf64_get_synthetic_symtab	    elf_x86_64_get_synthetic_symtab
@@ -4019,6 +4019,7 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
   struct bfd_hash_entry **old_table = NULL;
   unsigned int old_size = 0;
   unsigned int old_count = 0;
+  unsigned int old_deleted = 0;
   void *old_tab = NULL;
   void *old_ent;
   struct bfd_link_hash_entry *old_undefs = NULL;
@@ -4405,11 +4406,24 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
       extsymoff = hdr->sh_info;
     }
 
+  /* Use the symbols swapped in by bfd_elf_link_prefetch_symbols, if
+     they are the ones wanted here.  */
+  isymbuf = elf_tdata (abfd)->prefetched_syms;
+  elf_tdata (abfd)->prefetched_syms = NULL;
+  if (isymbuf != NULL
+      && (hdr != &elf_tdata (abfd)->symtab_hdr
+	  || elf_tdata (abfd)->prefetched_symcount != extsymcount))
+    {
+      free (isymbuf);
+      isymbuf = NULL;
+    }
+
   sym_hash = elf_sym_hashes (abfd);
   if (extsymcount != 0)
     {
-      isymbuf = bfd_elf_get_elf_syms (abfd, hdr, extsymcount, extsymoff,
-				      NULL, NULL, NULL);
+      if (isymbuf == NULL)
+	isymbuf = bfd_elf_get_elf_syms (abfd, hdr, extsymcount, extsymoff,
+					NULL, NULL, NULL);
       if (isymbuf == NULL)
 	goto error_return;
 
@@ -4472,6 +4486,10 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
 	}
 
       tabsize = htab->root.table.size * sizeof (struct bfd_hash_entry *);
+      /* An open addressed table has a tag byte per slot after the
+	 slots.  */
+      if (htab->root.table.open_addressing)
+	tabsize += htab->root.table.size;
       old_tab = bfd_malloc (tabsize + entsize);
       if (old_tab == NULL)
 	goto error_free_vers;
@@ -4496,6 +4514,7 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
       old_table = htab->root.table.table;
       old_size = htab->root.table.size;
       old_count = htab->root.table.count;
+      old_deleted = htab->root.table.deleted;
       old_strtab = NULL;
       if (htab->dynstr != NULL)
 	{
@@ -5321,6 +5340,7 @@ elf_link_add_object_symbols (bfd *abfd, struct bfd_link_info *info)
       htab->root.table.table = old_table;
       htab->root.table.size = old_size;
       htab->root.table.count = old_count;
+      htab->root.table.deleted = old_deleted;
       memcpy (htab->root.table.table, old_tab, tabsize);
       htab->root.undefs = old_undefs;
       htab->root.undefs_tail = old_undefs_tail;
@@ -5730,6 +5750,258 @@ _bfd_elf_archive_symbol_lookup (bfd *abfd,
   return h;
 }
 
+/* An index of the armap of an archive, for elf_link_add_archive_symbols.
+   Each armap name is entered in TABLE along with the names that
+   _bfd_elf_archive_symbol_lookup also tries for it, and maps to the
+   armap entries with that name.  A pass over the archive can then look
+   up the undefined symbols of the link in the armap, instead of
+   looking up every armap entry in the linker hash table.  HEAP holds
+   the armap entries to look at in the current pass, so that they are
+   still visited in armap order.  */
+
+struct elf_armap_sym
+{
+  struct elf_armap_sym *next;
+  symindex indx;
+};
+
+struct elf_armap_entry
+{
+  struct bfd_hash_entry root;
+  struct elf_armap_sym *syms;
+};
+
+struct elf_armap_index
+{
+  struct bfd_hash_table table;
+  symindex *heap;
+  symindex heap_count;
+};
+
+/* Set in the INCLUDED array of elf_link_add_archive_symbols for an
+   armap entry that is on the heap.  */
+#define ELF_ARMAP_QUEUED 2
+
+static struct bfd_hash_entry *
+elf_armap_newfunc (struct bfd_hash_entry *entry,
+		   struct bfd_hash_table *table,
+		   const char *string)
+{
+  if (entry == NULL)
+    {
+      entry = (struct bfd_hash_entry *)
+	bfd_hash_allocate (table, sizeof (struct elf_armap_entry));
+      if (entry == NULL)
+	return entry;
+    }
+
+  entry = bfd_hash_newfunc (entry, table, string);
+  if (entry != NULL)
+    ((struct elf_armap_entry *) entry)->syms = NULL;
+  return entry;
+}
+
+/* Record that armap entry INDX is found by looking up NAME.  */
+
+static bfd_boolean
+elf_armap_add (struct elf_armap_index *armap, const char *name,
+	       bfd_boolean copy, symindex indx)
+{
+  struct elf_armap_entry *ent;
+  struct elf_armap_sym *sym;
+
+  ent = (struct elf_armap_entry *) bfd_hash_lookup (&armap->table, name,
+						    TRUE, copy);
+  if (ent == NULL)
+    return FALSE;
+  sym = (struct elf_armap_sym *) bfd_hash_allocate (&armap->table,
+						    sizeof (*sym));
+  if (sym == NULL)
+    return FALSE;
+  sym->indx = indx;
+  sym->next = ent->syms;
+  ent->syms = sym;
+  return TRUE;
+}
+
+static void
+elf_armap_free (struct elf_armap_index *armap)
+{
+  if (armap == NULL)
+    return;
+  bfd_hash_table_free (&armap->table);
+  free (armap->heap);
+  free (armap);
+}
+
+/* Build the index of the armap of ABFD.  Return NULL on error.  */
+
+static struct elf_armap_index *
+elf_armap_create (bfd *abfd)
+{
+  struct elf_armap_index *armap;
+  carsym *symdefs = bfd_ardata (abfd)->symdefs;
+  symindex c = bfd_ardata (abfd)->symdef_count;
+  symindex i;
+  char *copy = NULL;
+  size_t copy_size = 0;
+
+  armap = (struct elf_armap_index *) bfd_zmalloc (sizeof (*armap));
+  if (armap == NULL)
+    return NULL;
+  if (!bfd_hash_table_init_n (&armap->table, elf_armap_newfunc,
+			      sizeof (struct elf_armap_entry),
+			      c < 0x1000000 ? (unsigned int) c : 0x1000000))
+    {
+      free (armap);
+      return NULL;
+    }
+  if (!bfd_hash_table_open_addressing (&armap->table))
+    goto error_return;
+  armap->heap = (symindex *) bfd_malloc (c * sizeof (*armap->heap));
+  if (armap->heap == NULL)
+    goto error_return;
+
+  for (i = 0; i < c; i++)
+    {
+      const char *name = symdefs[i].name;
+      const char *p;
+      size_t len, first;
+
+      if (!elf_armap_add (armap, name, FALSE, i))
+	goto error_return;
+
+      /* A default version is also found by the name with one `@',
+	 and by the name without the version.  */
+      p = strchr (name, ELF_VER_CHR);
+      if (p == NULL || p[1] != ELF_VER_CHR)
+	continue;
+
+      len = strlen (name);
+      if (len > copy_size)
+	{
+	  free (copy);
+	  copy_size = len * 2;
+	  copy = (char *) bfd_malloc (copy_size);
+	  if (copy == NULL)
+	    goto error_return;
+	}
+      first = p - name + 1;
+      memcpy (copy, name, first);
+      memcpy (copy + first, name + first + 1, len - first);
+      if (!elf_armap_add (armap, copy, TRUE, i))
+	goto error_return;
+      copy[first - 1] = '\0';
+      if (!elf_armap_add (armap, copy, TRUE, i))
+	goto error_return;
+    }
+
+  free (copy);
+  return armap;
+
+ error_return:
+  free (copy);
+  elf_armap_free (armap);
+  return NULL;
+}
+
+/* Add the armap entries after FROM that may be found by looking up
+   the undefined symbol H to the heap.  */
+
+static void
+elf_armap_queue (struct elf_armap_index *armap, unsigned char *included,
+		 struct bfd_link_hash_entry *h, symindex from)
+{
+  struct elf_armap_entry *ent;
+  struct elf_armap_sym *sym;
+
+  /* Only an armap entry whose symbol is undefined or common (or
+     undefweak, which may become undefined during the pass) can pull
+     in a member.  Such a symbol is on the undefs list, which is where
+     H comes from.  */
+  if (h->type == bfd_link_hash_defined
+      || h->type == bfd_link_hash_defweak
+      || h->type == bfd_link_hash_new)
+    return;
+
+  ent = (struct elf_armap_entry *) bfd_hash_lookup (&armap->table,
+						    h->root.string,
+						    FALSE, FALSE);
+  if (ent == NULL)
+    return;
+
+  for (sym = ent->syms; sym != NULL; sym = sym->next)
+    {
+      symindex n, parent;
+
+      if (sym->indx < from || included[sym->indx] != 0)
+	continue;
+      included[sym->indx] = ELF_ARMAP_QUEUED;
+
+      for (n = armap->heap_count++; n > 0; n = parent)
+	{
+	  parent = (n - 1) / 2;
+	  if (armap->heap[parent] <= sym->indx)
+	    break;
+	  armap->heap[n] = armap->heap[parent];
+	}
+      armap->heap[n] = sym->indx;
+    }
+}
+
+/* Add the armap entries that may be found by looking up the undefined
+   symbols from UNDEF on to the heap.  Return FALSE, with nothing
+   queued, if more than LIMIT symbols would have to be looked up.  */
+
+static bfd_boolean
+elf_armap_queue_undefs (struct elf_armap_index *armap,
+			unsigned char *included,
+			struct bfd_link_hash_entry *undef,
+			symindex from, symindex limit)
+{
+  symindex count = 0;
+
+  for (; undef != NULL; undef = undef->u.undef.next)
+    {
+      if (++count > limit)
+	{
+	  while (armap->heap_count > 0)
+	    included[armap->heap[--armap->heap_count]] = 0;
+	  return FALSE;
+	}
+      elf_armap_queue (armap, included, undef, from);
+    }
+  return TRUE;
+}
+
+/* Remove the first armap entry from the heap and return it, or return
+   BFD_NO_MORE_SYMBOLS if the heap is empty.  */
+
+static symindex
+elf_armap_next (struct elf_armap_index *armap, unsigned char *included)
+{
+  symindex first, last, n, child;
+
+  if (armap->heap_count == 0)
+    return BFD_NO_MORE_SYMBOLS;
+
+  first = armap->heap[0];
+  last = armap->heap[--armap->heap_count];
+  for (n = 0; (child = 2 * n + 1) < armap->heap_count; n = child)
+    {
+      if (child + 1 < armap->heap_count
+	  && armap->heap[child + 1] < armap->heap[child])
+	child++;
+      if (last <= armap->heap[child])
+	break;
+      armap->heap[n] = armap->heap[child];
+    }
+  armap->heap[n] = last;
+
+  included[first] &= ~ELF_ARMAP_QUEUED;
+  return first;
+}
+
 /* Add symbols from an ELF archive file to the linker hash table.  We
    don't use _bfd_generic_link_add_archive_symbols because we need to
    handle versioned symbols.
@@ -5741,7 +6013,9 @@ _bfd_elf_archive_symbol_lookup (bfd *abfd,
    object file.
 
    Unfortunately, we do have to make multiple passes over the symbol
-   table until nothing further is resolved.  */
+   table until nothing further is resolved.  Each pass normally looks
+   up the undefined symbols of the link in an index of the armap,
+   rather than looking up each armap entry in the linker hash table.  */
 
 static bfd_boolean
 elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
@@ -5754,6 +6028,8 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
   const struct elf_backend_data *bed;
   struct elf_link_hash_entry * (*archive_symbol_lookup)
     (bfd *, struct bfd_link_info *, const char *);
+  struct elf_armap_index *armap = NULL;
+  bfd_boolean first_pass = TRUE;
 
   if (! bfd_has_map (abfd))
     {
@@ -5783,21 +6059,48 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
     {
       file_ptr last;
       symindex i;
-      carsym *symdef;
-      carsym *symdefend;
+      bfd_boolean indexed;
 
       loop = FALSE;
       last = -1;
 
-      symdef = symdefs;
-      symdefend = symdef + c;
-      for (i = 0; symdef < symdefend; symdef++, i++)
+      /* Building the index costs more than one pass over the armap,
+	 so it is only built for a second pass.  The index only knows
+	 the names that _bfd_elf_archive_symbol_lookup tries.  */
+      if (armap == NULL
+	  && !first_pass
+	  && archive_symbol_lookup == _bfd_elf_archive_symbol_lookup)
+	{
+	  armap = elf_armap_create (abfd);
+	  if (armap == NULL)
+	    goto error_return;
+	}
+      first_pass = FALSE;
+
+      /* Look at every armap entry if there are more undefined
+	 symbols than armap entries.  */
+      indexed = (armap != NULL
+		 && elf_armap_queue_undefs (armap, included,
+					    info->hash->undefs, 0, c));
+
+      for (i = 0; ; i++)
 	{
+	  carsym *symdef;
 	  struct elf_link_hash_entry *h;
 	  bfd *element;
 	  struct bfd_link_hash_entry *undefs_tail;
 	  symindex mark;
 
+	  if (indexed)
+	    {
+	      i = elf_armap_next (armap, included);
+	      if (i == BFD_NO_MORE_SYMBOLS)
+		break;
+	    }
+	  else if (i >= c)
+	    break;
+	  symdef = symdefs + i;
+
 	  if (included[i])
 	    continue;
 	  if (symdef->file_offset == last)
@@ -5862,7 +6165,18 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 	     does not require another pass.  This isn't a bug, but it
 	     does make the code less efficient than it could be.  */
 	  if (undefs_tail != info->hash->undefs_tail)
-	    loop = TRUE;
+	    {
+	      loop = TRUE;
+
+	      /* The new undefined symbols may be defined by armap
+		 entries later in this pass.  */
+	      if (indexed)
+		elf_armap_queue_undefs (armap, included,
+					(undefs_tail != NULL
+					 ? undefs_tail->u.undef.next
+					 : info->hash->undefs),
+					i + 1, BFD_NO_MORE_SYMBOLS);
+	    }
 
 	  /* Look backward to mark all symbols from this object file
 	     which we have already seen in this pass.  */
@@ -5877,20 +6191,134 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 	  while (symdefs[mark].file_offset == symdef->file_offset);
 
 	  /* We mark subsequent symbols from this object file as we go
-	     on through the loop.  */
+	     on through the loop, or here if we only look at some of
+	     them.  */
 	  last = symdef->file_offset;
+	  if (indexed)
+	    for (mark = i + 1;
+		 mark < c && symdefs[mark].file_offset == last;
+		 mark++)
+	      included[mark] = TRUE;
 	}
     }
   while (loop);
 
+  elf_armap_free (armap);
   free (included);
   return TRUE;
 
  error_return:
+  elf_armap_free (armap);
   free (included);
   return FALSE;
 }
 
+/* The global symbols of one object, for bfd_elf_link_prefetch_symbols.  */
+
+struct elf_prefetch_syms
+{
+  bfd *abfd;
+  bfd_byte *extsyms;
+  size_t count;
+  Elf_Internal_Sym *isyms;
+  bfd_boolean ok;
+};
+
+/* Swap in the symbols of the I'th object in DATA, an array of
+   struct elf_prefetch_syms.  This runs in a worker thread.  */
+
+static void
+elf_prefetch_swap_syms (void *data, size_t i)
+{
+  struct elf_prefetch_syms *p = (struct elf_prefetch_syms *) data + i;
+  const struct elf_backend_data *bed;
+  size_t extsym_size;
+  size_t j;
+
+  if (p->isyms == NULL)
+    return;
+
+  bed = get_elf_backend_data (p->abfd);
+  extsym_size = bed->s->sizeof_sym;
+  for (j = 0; j < p->count; j++)
+    if (!(*bed->s->swap_symbol_in) (p->abfd, p->extsyms + j * extsym_size,
+				    NULL, p->isyms + j))
+      return;
+  p->ok = TRUE;
+}
+
+/* Read the global symbols of the COUNT objects in ABFDS, and swap them
+   in using the threads allowed by bfd_set_max_threads, for
+   elf_link_add_object_symbols to pick up when each object is added
+   to the link.  The files are read in the calling thread.  Nothing is
+   reported here: the symbols of objects that can't be read, or that
+   need a SHT_SYMTAB_SHNDX section, are left for
+   elf_link_add_object_symbols to read as usual.  */
+
+void
+bfd_elf_link_prefetch_symbols (bfd **abfds, size_t count)
+{
+  struct elf_prefetch_syms *syms;
+  size_t i;
+
+  if (count == 0)
+    return;
+
+  syms = (struct elf_prefetch_syms *) bfd_zmalloc (count * sizeof (*syms));
+  if (syms == NULL)
+    return;
+
+  for (i = 0; i < count; i++)
+    {
+      bfd *abfd = abfds[i];
+      const struct elf_backend_data *bed;
+      Elf_Internal_Shdr *hdr;
+      size_t symcount, extsymoff, amt;
+
+      if (bfd_get_flavour (abfd) != bfd_target_elf_flavour
+	  || bfd_get_format (abfd) != bfd_object
+	  || (abfd->flags & DYNAMIC) != 0
+	  || elf_tdata (abfd)->prefetched_syms != NULL
+	  || elf_symtab_shndx_list (abfd) != NULL)
+	continue;
+
+      bed = get_elf_backend_data (abfd);
+      hdr = &elf_tdata (abfd)->symtab_hdr;
+      symcount = hdr->sh_size / bed->s->sizeof_sym;
+      extsymoff = elf_bad_symtab (abfd) ? 0 : hdr->sh_info;
+      if (symcount <= extsymoff)
+	continue;
+
+      syms[i].abfd = abfd;
+      syms[i].count = symcount - extsymoff;
+      amt = syms[i].count * bed->s->sizeof_sym;
+      syms[i].extsyms = (bfd_byte *) bfd_malloc (amt);
+      if (syms[i].extsyms == NULL
+	  || bfd_seek (abfd, hdr->sh_offset + extsymoff * bed->s->sizeof_sym,
+		       SEEK_SET) != 0
+	  || bfd_bread (syms[i].extsyms, amt, abfd) != amt)
+	continue;
+
+      if (!_bfd_mul_overflow (syms[i].count, sizeof (Elf_Internal_Sym), &amt))
+	syms[i].isyms = (Elf_Internal_Sym *) bfd_malloc (amt);
+    }
+
+  bfd_parallel_for (count, elf_prefetch_swap_syms, syms);
+
+  for (i = 0; i < count; i++)
+    {
+      if (syms[i].ok)
+	{
+	  elf_tdata (syms[i].abfd)->prefetched_syms = syms[i].isyms;
+	  elf_tdata (syms[i].abfd)->prefetched_symcount = syms[i].count;
+	}
+      else
+	free (syms[i].isyms);
+      free (syms[i].extsyms);
+    }
+  free (syms);
+}
+
 /* Given an ELF BFD, add symbols to the global hash table as
    appropriate.  */
 
@@ -7560,78 +7988,697 @@ bfd_elf_size_dynsym_hash_dynstr (bfd *output_bfd, struct bfd_link_info *info)
   return TRUE;
 }
 
-/* Make sure sec_info_type is cleared if sec_info is cleared too.  */
+/* Identical code folding.  A relocation of a section considered by
+   --icf.  Two relocations are the same if they have the same offset,
+   type and addend, and the same target.  The target is either a
+   symbol H that might not resolve to its definition in this link, or
+   else offset VALUE into section SEC.  When SEC is itself considered
+   for folding, TARGET is its index and SEC is compared by class.  */
+
+struct elf_icf_reloc
+{
+  bfd_vma offset;
+  bfd_vma addend;
+  bfd_vma value;
+  bfd_vma type;
+  struct elf_link_hash_entry *h;
+  asection *sec;
+  size_t target;
+};
 
-static void
-merge_sections_remove_hook (bfd *abfd ATTRIBUTE_UNUSED,
-			    asection *sec)
+/* An input section considered by --icf.  */
+
+struct elf_icf_section
 {
-  BFD_ASSERT (sec->sec_info_type == SEC_INFO_TYPE_MERGE);
-  sec->sec_info_type = SEC_INFO_TYPE_NONE;
+  asection *sec;
+  bfd_byte *contents;
+  struct elf_icf_reloc *relocs;
+  size_t reloc_count;
+  /* A hash of the section, equal for all the sections of a class.  */
+  unsigned int hash;
+  /* FALSE if the section could not be read.  It is then in a class
+     of its own.  */
+  bfd_boolean ok;
+  /* TRUE if CONTENTS is cached by the section and not to be freed.  */
+  bfd_boolean cached;
+  /* The class of the section, the index of its first member.  */
+  size_t class;
+  size_t new_class;
+};
+
+/* The state of identical code folding.  */
+
+struct elf_icf
+{
+  struct elf_icf_section *secs;
+  size_t count;
+  /* Index into SECS of each section, by section id.  Anything not
+     below COUNT means the section is not considered.  */
+  size_t *index;
+  unsigned int id_limit;
+};
+
+#define ELF_ICF_NONE ((size_t) -1)
+
+/* Add LEN bytes at P to HASH.  */
+
+static unsigned int
+elf_icf_hash (unsigned int hash, const void *p, size_t len)
+{
+  const unsigned char *s = (const unsigned char *) p;
+
+  while (len-- != 0)
+    hash = (hash ^ *s++) * 0x01000193;
+  return hash;
 }
 
-/* Finish SHF_MERGE section merging.  */
+/* Return the index of section SEC in ICF, or ELF_ICF_NONE.  */
 
-bfd_boolean
-_bfd_elf_merge_sections (bfd *obfd, struct bfd_link_info *info)
+static size_t
+elf_icf_index (const struct elf_icf *icf, const asection *sec)
 {
-  bfd *ibfd;
-  asection *sec;
+  size_t i;
 
-  if (!is_elf_hash_table (info->hash))
-    return FALSE;
+  if (sec == NULL || sec->id >= icf->id_limit)
+    return ELF_ICF_NONE;
+  i = icf->index[sec->id];
+  return i < icf->count ? i : ELF_ICF_NONE;
+}
 
-  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
-    if ((ibfd->flags & DYNAMIC) == 0
-	&& bfd_get_flavour (ibfd) == bfd_target_elf_flavour
-	&& (elf_elfheader (ibfd)->e_ident[EI_CLASS]
-	    == get_elf_backend_data (obfd)->s->elfclass))
-      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
-	if ((sec->flags & SEC_MERGE) != 0
-	    && !bfd_is_abs_section (sec->output_section))
-	  {
-	    struct bfd_elf_section_data *secdata;
+/* Return TRUE if input bfd IBFD may have sections folded.  */
 
-	    secdata = elf_section_data (sec);
-	    if (! _bfd_add_merge_section (obfd,
-					  &elf_hash_table (info)->merge_info,
-					  sec, &secdata->sec_info))
-	      return FALSE;
-	    else if (secdata->sec_info)
-	      sec->sec_info_type = SEC_INFO_TYPE_MERGE;
-	  }
+static bfd_boolean
+elf_icf_bfd_p (bfd *ibfd, bfd *obfd, struct bfd_link_info *info)
+{
+  const struct elf_backend_data *bed = get_elf_backend_data (obfd);
 
-  if (elf_hash_table (info)->merge_info != NULL)
-    _bfd_merge_sections (obfd, info, elf_hash_table (info)->merge_info,
-			 merge_sections_remove_hook);
-  return TRUE;
+  return (bfd_get_flavour (ibfd) == bfd_target_elf_flavour
+	  && (ibfd->flags & DYNAMIC) == 0
+	  && elf_object_id (ibfd) == elf_hash_table_id (elf_hash_table (info))
+	  && (*bed->relocs_compatible) (ibfd->xvec, obfd->xvec)
+	  && !elf_bad_symtab (ibfd));
 }
 
-/* Create an entry in an ELF linker hash table.  */
+/* Return TRUE if SEC is a code section that may be folded.  Sections
+   kept by the linker script and sections other sections are ordered
+   by with SHF_LINK_ORDER are left alone.  */
 
-struct bfd_hash_entry *
-_bfd_elf_link_hash_newfunc (struct bfd_hash_entry *entry,
-			    struct bfd_hash_table *table,
-			    const char *string)
+static bfd_boolean
+elf_icf_section_p (const asection *sec)
 {
-  /* Allocate the structure if it has not already been allocated by a
-     subclass.  */
-  if (entry == NULL)
-    {
-      entry = (struct bfd_hash_entry *)
-	bfd_hash_allocate (table, sizeof (struct elf_link_hash_entry));
-      if (entry == NULL)
-	return entry;
-    }
+  const flagword mask = (SEC_ALLOC | SEC_LOAD | SEC_CODE | SEC_HAS_CONTENTS
+			 | SEC_EXCLUDE | SEC_KEEP | SEC_GROUP | SEC_MERGE
+			 | SEC_LINKER_CREATED);
+
+  return ((sec->flags & mask) == (SEC_ALLOC | SEC_LOAD | SEC_CODE
+				  | SEC_HAS_CONTENTS)
+	  && sec->size != 0
+	  && (sec->rawsize == 0 || sec->rawsize == sec->size)
+	  && sec->sec_info_type == SEC_INFO_TYPE_NONE
+	  && sec->output_section != NULL
+	  && !bfd_is_abs_section (sec->output_section)
+	  && elf_section_type (sec) == SHT_PROGBITS
+	  && elf_linked_to_section (sec) == NULL);
+}
 
-  /* Call the allocation method of the superclass.  */
-  entry = _bfd_link_hash_newfunc (entry, table, string);
-  if (entry != NULL)
-    {
-      struct elf_link_hash_entry *ret = (struct elf_link_hash_entry *) entry;
-      struct elf_link_hash_table *htab = (struct elf_link_hash_table *) table;
+/* Fill in R, the target of relocation REL in input bfd IBFD, given the
+   local symbols ISYMBUF.  Return FALSE if the target is not one that
+   can be compared.  */
 
-      /* Set local fields.  */
+static bfd_boolean
+elf_icf_reloc_target (struct elf_icf_reloc *r, bfd *ibfd,
+		      struct bfd_link_info *info,
+		      Elf_Internal_Sym *isymbuf, unsigned long r_symndx)
+{
+  Elf_Internal_Shdr *symtab_hdr = &elf_tdata (ibfd)->symtab_hdr;
+  struct elf_link_hash_entry *h;
+  asection *sec;
+
+  r->h = NULL;
+  r->sec = NULL;
+  r->value = 0;
+  if (r_symndx == STN_UNDEF)
+    return TRUE;
+
+  if (r_symndx < symtab_hdr->sh_info)
+    {
+      Elf_Internal_Sym *isym = isymbuf + r_symndx;
+
+      if (ELF_ST_TYPE (isym->st_info) == STT_GNU_IFUNC)
+	return FALSE;
+      r->sec = bfd_section_from_elf_index (ibfd, isym->st_shndx);
+      r->value = isym->st_value;
+      return r->sec != NULL;
+    }
+
+  h = elf_sym_hashes (ibfd)[r_symndx - symtab_hdr->sh_info];
+  if (h == NULL)
+    return FALSE;
+  while (h->root.type == bfd_link_hash_indirect
+	 || h->root.type == bfd_link_hash_warning)
+    h = (struct elf_link_hash_entry *) h->root.u.i.link;
+
+  /* References to different symbols only resolve the same way if the
+     symbols are defined at the same place by regular objects, and are
+     not dynamic symbols that may be preempted.  */
+  if (h->root.type == bfd_link_hash_defined
+      || h->root.type == bfd_link_hash_defweak)
+    {
+      sec = h->root.u.def.section;
+      if (h->type != STT_GNU_IFUNC
+	  && (sec->owner == NULL || (sec->owner->flags & DYNAMIC) == 0)
+	  && (!bfd_link_pic (info)
+	      || h->forced_local
+	      || ELF_ST_VISIBILITY (h->other) != STV_DEFAULT))
+	{
+	  r->sec = sec;
+	  r->value = h->root.u.def.value;
+	  return TRUE;
+	}
+    }
+  r->h = h;
+  return TRUE;
+}
+
+/* Read the contents and relocs of the section S of ICF, which belongs
+   to IBFD with local symbols ISYMBUF.  */
+
+static bfd_boolean
+elf_icf_read_section (struct elf_icf *icf, struct elf_icf_section *s,
+		      bfd *ibfd, struct bfd_link_info *info,
+		      Elf_Internal_Sym *isymbuf)
+{
+  const struct elf_backend_data *bed = get_elf_backend_data (ibfd);
+  asection *sec = s->sec;
+  Elf_Internal_Rela *internal_relocs, *rel;
+  unsigned int r_sym_shift;
+  bfd_vma r_type_mask;
+  size_t i = 0;
+
+  if (elf_section_data (sec)->this_hdr.contents != NULL)
+    {
+      s->contents = elf_section_data (sec)->this_hdr.contents;
+      s->cached = TRUE;
+    }
+  else if (!bfd_malloc_and_get_section (ibfd, sec, &s->contents))
+    return FALSE;
+
+  if ((sec->flags & SEC_RELOC) == 0 || sec->reloc_count == 0)
+    return TRUE;
+
+  internal_relocs = _bfd_elf_link_read_relocs (ibfd, sec, NULL, NULL,
+					       info->keep_memory);
+  if (internal_relocs == NULL)
+    return FALSE;
+
+  if (bed->s->arch_size == 32)
+    {
+      r_type_mask = 0xff;
+      r_sym_shift = 8;
+    }
+  else
+    {
+      r_type_mask = 0xffffffff;
+      r_sym_shift = 32;
+    }
+
+  s->reloc_count = sec->reloc_count * bed->s->int_rels_per_ext_rel;
+  s->relocs = (struct elf_icf_reloc *)
+    bfd_malloc (s->reloc_count * sizeof (*s->relocs));
+  if (s->relocs != NULL)
+    for (i = 0, rel = internal_relocs; i < s->reloc_count; i++, rel++)
+      {
+	struct elf_icf_reloc *r = s->relocs + i;
+
+	r->offset = rel->r_offset;
+	r->addend = rel->r_addend;
+	r->type = rel->r_info & r_type_mask;
+	if (!elf_icf_reloc_target (r, ibfd, info, isymbuf,
+				   rel->r_info >> r_sym_shift))
+	  break;
+	r->target = elf_icf_index (icf, r->sec);
+      }
+
+  if (elf_section_data (sec)->relocs != internal_relocs)
+    free (internal_relocs);
+  if (s->relocs == NULL || i != s->reloc_count)
+    {
+      /* Only the first I relocs have been filled in.  */
+      s->reloc_count = i;
+      return FALSE;
+    }
+  return TRUE;
+}
+
+/* Hash the contents and relocs of the I'th section of DATA, a struct
+   elf_icf, ignoring the classes of the sections the relocs refer to.
+   This runs in a worker thread.  */
+
+static void
+elf_icf_hash_contents (void *data, size_t i)
+{
+  struct elf_icf_section *s = ((struct elf_icf *) data)->secs + i;
+  unsigned int hash = 0x811c9dc5;
+  size_t j;
+
+  if (!s->ok)
+    return;
+
+  hash = elf_icf_hash (hash, s->contents, s->sec->size);
+  for (j = 0; j < s->reloc_count; j++)
+    {
+      struct elf_icf_reloc *r = s->relocs + j;
+
+      hash = elf_icf_hash (hash, &r->offset, sizeof (r->offset));
+      hash = elf_icf_hash (hash, &r->addend, sizeof (r->addend));
+      hash = elf_icf_hash (hash, &r->value, sizeof (r->value));
+      hash = elf_icf_hash (hash, &r->type, sizeof (r->type));
+      if (r->target == ELF_ICF_NONE)
+	{
+	  hash = elf_icf_hash (hash, &r->h, sizeof (r->h));
+	  hash = elf_icf_hash (hash, &r->sec, sizeof (r->sec));
+	}
+    }
+  s->hash = hash;
+}
+
+/* Hash the classes of the sections the relocs of the I'th section of
+   DATA, a struct elf_icf, refer to.  This runs in a worker thread.  */
+
+static void
+elf_icf_hash_targets (void *data, size_t i)
+{
+  struct elf_icf *icf = (struct elf_icf *) data;
+  struct elf_icf_section *s = icf->secs + i;
+  unsigned int hash = 0x811c9dc5;
+  size_t j;
+
+  if (!s->ok)
+    return;
+
+  for (j = 0; j < s->reloc_count; j++)
+    if (s->relocs[j].target != ELF_ICF_NONE)
+      {
+	size_t class = icf->secs[s->relocs[j].target].class;
+
+	hash = elf_icf_hash (hash, &class, sizeof (class));
+      }
+  s->hash = hash;
+}
+
+/* Return TRUE if sections A and B have the same contents and relocs,
+   ignoring the classes of the sections the relocs refer to.  */
+
+static bfd_boolean
+elf_icf_same_contents_p (const struct elf_icf_section *a,
+			 const struct elf_icf_section *b)
+{
+  size_t j;
+
+  if (!a->ok
+      || !b->ok
+      || a->sec->size != b->sec->size
+      || a->sec->alignment_power != b->sec->alignment_power
+      || a->sec->output_section != b->sec->output_section
+      || elf_section_flags (a->sec) != elf_section_flags (b->sec)
+      || a->reloc_count != b->reloc_count
+      || memcmp (a->contents, b->contents, a->sec->size) != 0)
+    return FALSE;
+
+  for (j = 0; j < a->reloc_count; j++)
+    {
+      const struct elf_icf_reloc *ra = a->relocs + j;
+      const struct elf_icf_reloc *rb = b->relocs + j;
+
+      if (ra->offset != rb->offset
+	  || ra->addend != rb->addend
+	  || ra->value != rb->value
+	  || ra->type != rb->type
+	  || (ra->target == ELF_ICF_NONE) != (rb->target == ELF_ICF_NONE)
+	  || (ra->target == ELF_ICF_NONE
+	      && (ra->h != rb->h || ra->sec != rb->sec)))
+	return FALSE;
+    }
+  return TRUE;
+}
+
+/* Return TRUE if the relocs of sections A and B, which have the same
+   contents, refer to sections of the same classes.  */
+
+static bfd_boolean
+elf_icf_same_targets_p (const struct elf_icf *icf,
+			const struct elf_icf_section *a,
+			const struct elf_icf_section *b)
+{
+  size_t j;
+
+  for (j = 0; j < a->reloc_count; j++)
+    if (a->relocs[j].target != ELF_ICF_NONE
+	&& (icf->secs[a->relocs[j].target].class
+	    != icf->secs[b->relocs[j].target].class))
+      return FALSE;
+  return TRUE;
+}
+
+/* Sort sections by class, then hash, then link order.  */
+
+static int
+elf_icf_compare (const void *a, const void *b)
+{
+  const struct elf_icf_section *sa = *(const struct elf_icf_section **) a;
+  const struct elf_icf_section *sb = *(const struct elf_icf_section **) b;
+
+  if (sa->class != sb->class)
+    return sa->class < sb->class ? -1 : 1;
+  if (sa->hash != sb->hash)
+    return sa->hash < sb->hash ? -1 : 1;
+  if (sa != sb)
+    return sa < sb ? -1 : 1;
+  return 0;
+}
+
+/* Split the classes of the sections of ICF, using the sections in
+   ORDER sorted by elf_icf_compare.  A section joins the class of the
+   first earlier section of its class and hash that SAME says it
+   matches.  Return TRUE if any class was split.  */
+
+static bfd_boolean
+elf_icf_split_classes (struct elf_icf *icf, struct elf_icf_section **order,
+		       bfd_boolean (*same) (const struct elf_icf *,
+					    const struct elf_icf_section *,
+					    const struct elf_icf_section *))
+{
+  bfd_boolean split = FALSE;
+  size_t start, end, i, j;
+
+  for (start = 0; start < icf->count; start = end)
+    {
+      for (end = start + 1; end < icf->count; end++)
+	if (order[end]->class != order[start]->class
+	    || order[end]->hash != order[start]->hash)
+	  break;
+
+      for (i = start; i < end; i++)
+	{
+	  struct elf_icf_section *s = order[i];
+
+	  s->new_class = s - icf->secs;
+	  for (j = start; j < i; j++)
+	    if (order[j]->new_class == (size_t) (order[j] - icf->secs)
+		&& (*same) (icf, order[j], s))
+	      {
+		s->new_class = order[j]->new_class;
+		break;
+	      }
+	}
+    }
+
+  for (i = 0; i < icf->count; i++)
+    {
+      struct elf_icf_section *s = icf->secs + i;
+
+      if (s->new_class != s->class)
+	split = TRUE;
+      s->class = s->new_class;
+    }
+  return split;
+}
+
+/* elf_icf_split_classes callback for the first pass.  */
+
+static bfd_boolean
+elf_icf_same_contents (const struct elf_icf *icf ATTRIBUTE_UNUSED,
+		       const struct elf_icf_section *a,
+		       const struct elf_icf_section *b)
+{
+  return elf_icf_same_contents_p (a, b);
+}
+
+/* Point symbols defined in a folded section at the section it was
+   folded into.  This is called via elf_link_hash_traverse.  */
+
+static bfd_boolean
+elf_icf_redirect_symbol (struct elf_link_hash_entry *h, void *data)
+{
+  struct elf_icf *icf = (struct elf_icf *) data;
+  size_t i;
+
+  if (h->root.type != bfd_link_hash_defined
+      && h->root.type != bfd_link_hash_defweak)
+    return TRUE;
+
+  i = elf_icf_index (icf, h->root.u.def.section);
+  if (i != ELF_ICF_NONE && icf->secs[i].class != i)
+    h->root.u.def.section = icf->secs[icf->secs[i].class].sec;
+  return TRUE;
+}
+
+/* Fold identical code sections for --icf.  Sections are first put in
+   classes by hashing and comparing their contents and relocs, except
+   that references to other code sections only need to point at the
+   same offset of some code section.  Classes are then split until the
+   sections of each class also refer to sections of the same classes,
+   so that mutually recursive functions can be folded.  All but the
+   first section of a class are excluded from the link, with their
+   kept_section set to the first, and bfd_elf_final_link gives them
+   its address.  Failure to read a section only stops it being
+   folded.  */
+
+static void
+elf_icf_sections (bfd *obfd, struct bfd_link_info *info)
+{
+  struct elf_icf icf;
+  struct elf_icf_section **order;
+  bfd_boolean folded;
+  bfd *ibfd;
+  asection *sec;
+  size_t i;
+
+  icf.id_limit = _bfd_section_id;
+  icf.index = (size_t *) bfd_malloc (icf.id_limit * sizeof (*icf.index));
+  if (icf.index == NULL)
+    return;
+  memset (icf.index, 0xff, icf.id_limit * sizeof (*icf.index));
+
+  /* Leave alone sections that others have SHF_LINK_ORDER with.  */
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    if (elf_icf_bfd_p (ibfd, obfd, info))
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	{
+	  asection *linked = elf_linked_to_section (sec);
+
+	  if (linked != NULL && linked->id < icf.id_limit)
+	    icf.index[linked->id] = ELF_ICF_NONE - 1;
+	}
+
+  icf.count = 0;
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    if (elf_icf_bfd_p (ibfd, obfd, info))
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	if (elf_icf_section_p (sec)
+	    && sec->id < icf.id_limit
+	    && icf.index[sec->id] == ELF_ICF_NONE)
+	  icf.index[sec->id] = icf.count++;
+
+  icf.secs = NULL;
+  order = NULL;
+  if (icf.count < 2)
+    goto out;
+
+  icf.secs = (struct elf_icf_section *)
+    bfd_zmalloc (icf.count * sizeof (*icf.secs));
+  order = (struct elf_icf_section **)
+    bfd_malloc (icf.count * sizeof (*order));
+  if (icf.secs == NULL || order == NULL)
+    goto out;
+
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    {
+      Elf_Internal_Shdr *symtab_hdr;
+      Elf_Internal_Sym *isymbuf;
+      bfd_boolean have_syms;
+
+      if (!elf_icf_bfd_p (ibfd, obfd, info))
+	continue;
+
+      symtab_hdr = &elf_tdata (ibfd)->symtab_hdr;
+      isymbuf = NULL;
+      have_syms = FALSE;
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	{
+	  struct elf_icf_section *s;
+
+	  i = elf_icf_index (&icf, sec);
+	  if (i == ELF_ICF_NONE)
+	    continue;
+
+	  s = icf.secs + i;
+	  s->sec = sec;
+	  s->class = 0;
+	  if (!have_syms)
+	    {
+	      have_syms = TRUE;
+	      isymbuf = (Elf_Internal_Sym *) symtab_hdr->contents;
+	      if (isymbuf == NULL && symtab_hdr->sh_info != 0)
+		isymbuf = bfd_elf_get_elf_syms (ibfd, symtab_hdr,
+						symtab_hdr->sh_info, 0,
+						NULL, NULL, NULL);
+	    }
+	  if (isymbuf != NULL || symtab_hdr->sh_info == 0)
+	    s->ok = elf_icf_read_section (&icf, s, ibfd, info, isymbuf);
+	  if (!s->ok)
+	    s->class = i;
+	}
+
+      if (symtab_hdr->contents != (unsigned char *) isymbuf)
+	free (isymbuf);
+    }
+
+  /* Hashing the contents is where the time goes, so do it in
+     parallel.  */
+  bfd_parallel_for (icf.count, elf_icf_hash_contents, &icf);
+  for (i = 0; i < icf.count; i++)
+    order[i] = icf.secs + i;
+  qsort (order, icf.count, sizeof (*order), elf_icf_compare);
+  elf_icf_split_classes (&icf, order, elf_icf_same_contents);
+
+  do
+    {
+      bfd_parallel_for (icf.count, elf_icf_hash_targets, &icf);
+      qsort (order, icf.count, sizeof (*order), elf_icf_compare);
+    }
+  while (elf_icf_split_classes (&icf, order, elf_icf_same_targets_p));
+
+  folded = FALSE;
+  for (i = 0; i < icf.count; i++)
+    {
+      struct elf_icf_section *s = icf.secs + i;
+      asection *kept;
+
+      if (s->class == i)
+	continue;
+
+      kept = icf.secs[s->class].sec;
+      s->sec->flags |= SEC_EXCLUDE;
+      s->sec->kept_section = kept;
+      folded = TRUE;
+      if (info->print_icf_sections)
+	/* xgettext:c-format */
+	_bfd_error_handler (_("folding section '%pA' in file '%pB' into "
+			      "'%pA' in file '%pB'"),
+			    s->sec, s->sec->owner, kept, kept->owner);
+    }
+  if (folded)
+    elf_link_hash_traverse (elf_hash_table (info),
+			    elf_icf_redirect_symbol, &icf);
+
+ out:
+  if (icf.secs != NULL)
+    for (i = 0; i < icf.count; i++)
+      {
+	if (!icf.secs[i].cached)
+	  free (icf.secs[i].contents);
+	free (icf.secs[i].relocs);
+      }
+  free (order);
+  free (icf.secs);
+  free (icf.index);
+}
+
+/* Give sections folded by elf_icf_sections the output offset of the
+   section they were folded into, now that it is known.  */
+
+static void
+elf_icf_set_output_offsets (struct bfd_link_info *info)
+{
+  bfd *ibfd;
+  asection *sec;
+
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+      if ((sec->flags & (SEC_EXCLUDE | SEC_CODE)) == (SEC_EXCLUDE | SEC_CODE)
+	  && sec->kept_section != NULL
+	  && sec->output_section != NULL
+	  && !bfd_is_abs_section (sec->output_section)
+	  && sec->output_section == sec->kept_section->output_section)
+	sec->output_offset = sec->kept_section->output_offset;
+}
+
+/* Make sure sec_info_type is cleared if sec_info is cleared too.  */
+
+static void
+merge_sections_remove_hook (bfd *abfd ATTRIBUTE_UNUSED,
+			    asection *sec)
+{
+  BFD_ASSERT (sec->sec_info_type == SEC_INFO_TYPE_MERGE);
+  sec->sec_info_type = SEC_INFO_TYPE_NONE;
+}
+
+/* Finish SHF_MERGE section merging.  */
+
+bfd_boolean
+_bfd_elf_merge_sections (bfd *obfd, struct bfd_link_info *info)
+{
+  bfd *ibfd;
+  asection *sec;
+
+  if (!is_elf_hash_table (info->hash))
+    return FALSE;
+
+  if (info->icf && !bfd_link_relocatable (info))
+    elf_icf_sections (obfd, info);
+
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    if ((ibfd->flags & DYNAMIC) == 0
+	&& bfd_get_flavour (ibfd) == bfd_target_elf_flavour
+	&& (elf_elfheader (ibfd)->e_ident[EI_CLASS]
+	    == get_elf_backend_data (obfd)->s->elfclass))
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	if ((sec->flags & SEC_MERGE) != 0
+	    && !bfd_is_abs_section (sec->output_section))
+	  {
+	    struct bfd_elf_section_data *secdata;
+
+	    secdata = elf_section_data (sec);
+	    if (! _bfd_add_merge_section (obfd,
+					  &elf_hash_table (info)->merge_info,
+					  sec, &secdata->sec_info))
+	      return FALSE;
+	    else if (secdata->sec_info)
+	      sec->sec_info_type = SEC_INFO_TYPE_MERGE;
+	  }
+
+  if (elf_hash_table (info)->merge_info != NULL)
+    _bfd_merge_sections (obfd, info, elf_hash_table (info)->merge_info,
+			 merge_sections_remove_hook);
+  return TRUE;
+}
+
+/* Create an entry in an ELF linker hash table.  */
+
+struct bfd_hash_entry *
+_bfd_elf_link_hash_newfunc (struct bfd_hash_entry *entry,
+			    struct bfd_hash_table *table,
+			    const char *string)
+{
+  /* Allocate the structure if it has not already been allocated by a
+     subclass.  */
+  if (entry == NULL)
+    {
+      entry = (struct bfd_hash_entry *)
+	bfd_hash_allocate (table, sizeof (struct elf_link_hash_entry));
+      if (entry == NULL)
+	return entry;
+    }
+
+  /* Call the allocation method of the superclass.  */
+  entry = _bfd_link_hash_newfunc (entry, table, string);
+  if (entry != NULL)
+    {
+      struct elf_link_hash_entry *ret = (struct elf_link_hash_entry *) entry;
+      struct elf_link_hash_table *htab = (struct elf_link_hash_table *) table;
+
+      /* Set local fields.  */
       ret->indx = -1;
       ret->dynindx = -1;
       ret->got = htab->init_got_refcount;
@@ -7801,6 +8848,10 @@ _bfd_elf_link_hash_table_init
   table->dynsymcount = 1;
 
   ret = _bfd_link_hash_table_init (&table->root, abfd, newfunc, entsize);
+  /* Most symbols are looked up many times.  The chained table is kept
+     if open addressing can't be set up.  */
+  if (ret)
+    bfd_hash_table_open_addressing (&table->root.table);
 
   table->root.type = bfd_link_elf_hash_table;
   table->hash_table_id = target_id;
@@ -8394,6 +9445,18 @@ struct elf_final_link_info
   Elf_External_Sym_Shndx *symshndxbuf;
   /* Number of STT_FILE syms seen.  */
   size_t filesym_count;
+  /* Whether the backend may relocate some input sections in parallel.  */
+  bfd_boolean parallel_relocs;
+  /* Input sections queued by elf_link_input_bfd to be relocated in
+     parallel, and the bytes of contents and relocs they hold.  */
+  struct elf_reloc_job *reloc_jobs;
+  size_t reloc_job_count;
+  size_t reloc_job_alloc;
+  bfd_size_type reloc_job_size;
+  /* One more than the index in RELOC_JOBS of the job that owns the
+     copy of the local symbols of the input BFD being linked, or zero
+     if there is no such copy.  */
+  size_t reloc_job_syms;
 };
 
 /* This struct is used to pass information to elf_link_output_extsym.  */
@@ -10473,73 +11536,423 @@ elf_section_ignore_discarded_relocs (asection *sec)
   return FALSE;
 }
 
-/* Return a mask saying how ld should treat relocations in SEC against
-   symbols defined in discarded sections.  If this function returns
-   COMPLAIN set, ld will issue a warning message.  If this function
-   returns PRETEND set, and the discarded section was link-once and the
-   same size as the kept link-once section, ld will pretend that the
-   symbol was actually defined in the kept section.  Otherwise ld will
-   zero the reloc (at least that is the intent, but some cooperation by
-   the target dependent code is needed, particularly for REL targets).  */
+/* Return a mask saying how ld should treat relocations in SEC against
+   symbols defined in discarded sections.  If this function returns
+   COMPLAIN set, ld will issue a warning message.  If this function
+   returns PRETEND set, and the discarded section was link-once and the
+   same size as the kept link-once section, ld will pretend that the
+   symbol was actually defined in the kept section.  Otherwise ld will
+   zero the reloc (at least that is the intent, but some cooperation by
+   the target dependent code is needed, particularly for REL targets).  */
+
+unsigned int
+_bfd_elf_default_action_discarded (asection *sec)
+{
+  if (sec->flags & SEC_DEBUGGING)
+    return PRETEND;
+
+  if (strcmp (".eh_frame", sec->name) == 0)
+    return 0;
+
+  if (strcmp (".gcc_except_table", sec->name) == 0)
+    return 0;
+
+  return COMPLAIN | PRETEND;
+}
+
+/* Find a match between a section and a member of a section group.  */
+
+static asection *
+match_group_member (asection *sec, asection *group,
+		    struct bfd_link_info *info)
+{
+  asection *first = elf_next_in_group (group);
+  asection *s = first;
+
+  while (s != NULL)
+    {
+      if (bfd_elf_match_symbols_in_sections (s, sec, info))
+	return s;
+
+      s = elf_next_in_group (s);
+      if (s == first)
+	break;
+    }
+
+  return NULL;
+}
+
+/* Check if the kept section of a discarded section SEC can be used
+   to replace it.  Return the replacement if it is OK.  Otherwise return
+   NULL.  */
+
+asection *
+_bfd_elf_check_kept_section (asection *sec, struct bfd_link_info *info)
+{
+  asection *kept;
+
+  kept = sec->kept_section;
+  if (kept != NULL)
+    {
+      if ((kept->flags & SEC_GROUP) != 0)
+	kept = match_group_member (sec, kept, info);
+      if (kept != NULL
+	  && ((sec->rawsize != 0 ? sec->rawsize : sec->size)
+	      != (kept->rawsize != 0 ? kept->rawsize : kept->size)))
+	kept = NULL;
+      sec->kept_section = kept;
+    }
+  return kept;
+}
+
+/* An input section queued by elf_link_queue_relocs.  */
+
+struct elf_reloc_job
+{
+  bfd *input_bfd;
+  asection *sec;
+  /* Private copies of the contents and relocs of SEC.  */
+  bfd_byte *contents;
+  Elf_Internal_Rela *relocs;
+  /* Copies of the local symbols of INPUT_BFD and of their sections.
+     The later jobs for INPUT_BFD share them, and they are freed with
+     this job if OWN_SYMS.  */
+  Elf_Internal_Sym *local_syms;
+  asection **local_sections;
+  bfd_boolean own_syms;
+  /* What relocate_section returned.  */
+  int ret;
+};
+
+/* Queue up to this many bytes of contents and relocs per thread before
+   relocating them.  */
+#define ELF_RELOC_JOB_BYTES (16 * 1024 * 1024)
+
+/* The link info and callbacks that the worker threads of
+   elf_link_run_reloc_jobs pass to relocate_section.  */
+
+struct elf_reloc_jobs
+{
+  struct elf_final_link_info *flinfo;
+  struct bfd_link_info info;
+  struct bfd_link_callbacks callbacks;
+};
+
+/* Set when a worker thread of elf_link_run_reloc_jobs reports a
+   problem, under _bfd_parallel_lock.  */
+static bfd_boolean elf_reloc_jobs_failed;
+
+/* The callbacks used by the worker threads of elf_link_run_reloc_jobs
+   just note that there is something to report.  The jobs are then run
+   again in the calling thread, with the link's own callbacks.  */
+
+static void
+elf_reloc_job_failed (void)
+{
+  _bfd_parallel_lock ();
+  elf_reloc_jobs_failed = TRUE;
+  _bfd_parallel_unlock ();
+}
+
+static void
+elf_reloc_job_warning (struct bfd_link_info *info ATTRIBUTE_UNUSED,
+		       const char *warning ATTRIBUTE_UNUSED,
+		       const char *symbol ATTRIBUTE_UNUSED,
+		       bfd *abfd ATTRIBUTE_UNUSED,
+		       asection *section ATTRIBUTE_UNUSED,
+		       bfd_vma address ATTRIBUTE_UNUSED)
+{
+  elf_reloc_job_failed ();
+}
+
+static void
+elf_reloc_job_undefined_symbol (struct bfd_link_info *info ATTRIBUTE_UNUSED,
+				const char *name ATTRIBUTE_UNUSED,
+				bfd *abfd ATTRIBUTE_UNUSED,
+				asection *section ATTRIBUTE_UNUSED,
+				bfd_vma address ATTRIBUTE_UNUSED,
+				bfd_boolean is_fatal ATTRIBUTE_UNUSED)
+{
+  elf_reloc_job_failed ();
+}
+
+static void
+elf_reloc_job_reloc_overflow (struct bfd_link_info *info ATTRIBUTE_UNUSED,
+			      struct bfd_link_hash_entry *entry
+			      ATTRIBUTE_UNUSED,
+			      const char *name ATTRIBUTE_UNUSED,
+			      const char *reloc_name ATTRIBUTE_UNUSED,
+			      bfd_vma addend ATTRIBUTE_UNUSED,
+			      bfd *abfd ATTRIBUTE_UNUSED,
+			      asection *section ATTRIBUTE_UNUSED,
+			      bfd_vma address ATTRIBUTE_UNUSED)
+{
+  elf_reloc_job_failed ();
+}
+
+static void
+elf_reloc_job_reloc_dangerous (struct bfd_link_info *info ATTRIBUTE_UNUSED,
+			       const char *message ATTRIBUTE_UNUSED,
+			       bfd *abfd ATTRIBUTE_UNUSED,
+			       asection *section ATTRIBUTE_UNUSED,
+			       bfd_vma address ATTRIBUTE_UNUSED)
+{
+  elf_reloc_job_failed ();
+}
+
+static void
+elf_reloc_job_message (const char *fmt ATTRIBUTE_UNUSED, ...)
+{
+  elf_reloc_job_failed ();
+}
+
+static void
+elf_reloc_job_error_handler (const char *fmt ATTRIBUTE_UNUSED,
+			     va_list ap ATTRIBUTE_UNUSED)
+{
+  elf_reloc_job_failed ();
+}
+
+/* Relocate the section of the I'th job queued in the
+   elf_final_link_info of DATA, an elf_reloc_jobs.  */
+
+static void
+elf_reloc_job_run (void *data, size_t i)
+{
+  struct elf_reloc_jobs *jobs = (struct elf_reloc_jobs *) data;
+  struct elf_reloc_job *job = &jobs->flinfo->reloc_jobs[i];
+  bfd *output_bfd = jobs->flinfo->output_bfd;
+  const struct elf_backend_data *bed = get_elf_backend_data (output_bfd);
+
+  job->ret = (*bed->elf_backend_relocate_section) (output_bfd, &jobs->info,
+						   job->input_bfd, job->sec,
+						   job->contents, job->relocs,
+						   job->local_syms,
+						   job->local_sections);
+}
+
+/* Read the contents and relocs of the section of JOB again, as a
+   failed attempt to relocate it has changed them.  */
+
+static bfd_boolean
+elf_reloc_job_reread (struct elf_reloc_job *job)
+{
+  const struct elf_backend_data *bed = get_elf_backend_data (job->input_bfd);
+  asection *o = job->sec;
+  Elf_Internal_Rela *relocs;
+
+  if (elf_section_data (o)->this_hdr.contents != NULL)
+    memcpy (job->contents, elf_section_data (o)->this_hdr.contents, o->size);
+  else if (!bfd_get_full_section_contents (job->input_bfd, o, &job->contents))
+    return FALSE;
+
+  relocs = _bfd_elf_link_read_relocs (job->input_bfd, o, NULL, job->relocs,
+				      FALSE);
+  if (relocs == NULL)
+    return FALSE;
+  if (relocs != job->relocs)
+    memcpy (job->relocs, relocs,
+	    (o->reloc_count * bed->s->int_rels_per_ext_rel
+	     * sizeof (Elf_Internal_Rela)));
+  return TRUE;
+}
+
+/* Free the jobs queued in FLINFO.  */
 
-unsigned int
-_bfd_elf_default_action_discarded (asection *sec)
+static void
+elf_free_reloc_jobs (struct elf_final_link_info *flinfo)
 {
-  if (sec->flags & SEC_DEBUGGING)
-    return PRETEND;
-
-  if (strcmp (".eh_frame", sec->name) == 0)
-    return 0;
+  size_t i;
 
-  if (strcmp (".gcc_except_table", sec->name) == 0)
-    return 0;
+  for (i = 0; i < flinfo->reloc_job_count; i++)
+    {
+      struct elf_reloc_job *job = &flinfo->reloc_jobs[i];
 
-  return COMPLAIN | PRETEND;
+      free (job->contents);
+      free (job->relocs);
+      if (job->own_syms)
+	{
+	  free (job->local_syms);
+	  free (job->local_sections);
+	}
+    }
+  flinfo->reloc_job_count = 0;
+  flinfo->reloc_job_size = 0;
+  flinfo->reloc_job_syms = 0;
 }
 
-/* Find a match between a section and a member of a section group.  */
+/* Relocate the input sections queued by elf_link_queue_relocs, using
+   the threads allowed by bfd_set_max_threads, and write them out in
+   the calling thread.  If relocating any of them fails or reports
+   anything, relocate them all again in the calling thread, so that
+   the link's callbacks report the problems as usual.  */
 
-static asection *
-match_group_member (asection *sec, asection *group,
-		    struct bfd_link_info *info)
+static bfd_boolean
+elf_link_run_reloc_jobs (struct elf_final_link_info *flinfo)
 {
-  asection *first = elf_next_in_group (group);
-  asection *s = first;
+  bfd *output_bfd = flinfo->output_bfd;
+  const struct elf_backend_data *bed = get_elf_backend_data (output_bfd);
+  struct elf_reloc_jobs jobs;
+  bfd_error_handler_type error_handler;
+  bfd_boolean ret = TRUE;
+  size_t i;
 
-  while (s != NULL)
-    {
-      if (bfd_elf_match_symbols_in_sections (s, sec, info))
-	return s;
+  if (flinfo->reloc_job_count == 0)
+    return TRUE;
 
-      s = elf_next_in_group (s);
-      if (s == first)
-	break;
+  jobs.flinfo = flinfo;
+  jobs.info = *flinfo->info;
+  jobs.callbacks = *flinfo->info->callbacks;
+  jobs.callbacks.warning = elf_reloc_job_warning;
+  jobs.callbacks.undefined_symbol = elf_reloc_job_undefined_symbol;
+  jobs.callbacks.reloc_overflow = elf_reloc_job_reloc_overflow;
+  jobs.callbacks.reloc_dangerous = elf_reloc_job_reloc_dangerous;
+  jobs.callbacks.unattached_reloc = elf_reloc_job_reloc_dangerous;
+  jobs.callbacks.einfo = elf_reloc_job_message;
+  jobs.callbacks.info = elf_reloc_job_message;
+  jobs.callbacks.minfo = elf_reloc_job_message;
+  jobs.info.callbacks = &jobs.callbacks;
+
+  elf_reloc_jobs_failed = FALSE;
+  error_handler = bfd_set_error_handler (elf_reloc_job_error_handler);
+  bfd_parallel_for (flinfo->reloc_job_count, elf_reloc_job_run, &jobs);
+  bfd_set_error_handler (error_handler);
+  for (i = 0; i < flinfo->reloc_job_count; i++)
+    if (!flinfo->reloc_jobs[i].ret)
+      elf_reloc_jobs_failed = TRUE;
+
+  for (i = 0; ret && i < flinfo->reloc_job_count; i++)
+    {
+      struct elf_reloc_job *job = &flinfo->reloc_jobs[i];
+      asection *o = job->sec;
+      file_ptr offset;
+
+      if (elf_reloc_jobs_failed
+	  && (!elf_reloc_job_reread (job)
+	      || !(*bed->elf_backend_relocate_section) (output_bfd,
+							flinfo->info,
+							job->input_bfd, o,
+							job->contents,
+							job->relocs,
+							job->local_syms,
+							job->local_sections)))
+	ret = FALSE;
+      else
+	{
+	  offset = (file_ptr) o->output_offset;
+	  offset *= bfd_octets_per_byte (output_bfd, o);
+	  ret = bfd_set_section_contents (output_bfd, o->output_section,
+					  job->contents, offset, o->size);
+	}
     }
 
-  return NULL;
+  elf_free_reloc_jobs (flinfo);
+  return ret;
 }
 
-/* Check if the kept section of a discarded section SEC can be used
-   to replace it.  Return the replacement if it is OK.  Otherwise return
-   NULL.  */
+/* Queue input section O of INPUT_BFD, whose CONTENTS have been read
+   and whose RELOCS have been checked by elf_link_input_bfd, to be
+   relocated in parallel with other sections by
+   elf_link_run_reloc_jobs, and written out then.  ISYMBUF holds the
+   LOCSYMCOUNT local symbols of INPUT_BFD.  Return FALSE if O should
+   be relocated now instead, because it needs special handling, the
+   backend can't relocate it in a worker thread, or memory is short.  */
 
-asection *
-_bfd_elf_check_kept_section (asection *sec, struct bfd_link_info *info)
+static bfd_boolean
+elf_link_queue_relocs (struct elf_final_link_info *flinfo, bfd *input_bfd,
+		       asection *o, bfd_byte *contents,
+		       Elf_Internal_Rela *relocs, Elf_Internal_Sym *isymbuf,
+		       size_t locsymcount)
 {
-  asection *kept;
+  const struct elf_backend_data *bed;
+  Elf_Internal_Shdr *symtab_hdr;
+  struct elf_reloc_job *job;
+  bfd_size_type relsize;
 
-  kept = sec->kept_section;
-  if (kept != NULL)
+  bed = get_elf_backend_data (flinfo->output_bfd);
+  if (o->sec_info_type != SEC_INFO_TYPE_NONE
+      || (o->flags & (SEC_EXCLUDE | SEC_ELF_REVERSE_COPY)) != 0
+      || o->size == 0
+      || (o->rawsize != 0 && o->rawsize != o->size)
+      || o->reloc_count == 0
+      || !(*bed->elf_backend_can_relocate_in_parallel) (flinfo->info,
+							input_bfd, o, relocs,
+							isymbuf,
+							flinfo->sections))
+    return FALSE;
+
+  /* relocate_section may look up the names of local symbols to report
+     problems.  Read their string table now rather than in a worker
+     thread.  */
+  symtab_hdr = &elf_tdata (input_bfd)->symtab_hdr;
+  if (locsymcount != 0
+      && bfd_elf_string_from_elf_section (input_bfd, symtab_hdr->sh_link,
+					  0) == NULL)
+    return FALSE;
+
+  if (flinfo->reloc_job_count == flinfo->reloc_job_alloc)
     {
-      if ((kept->flags & SEC_GROUP) != 0)
-	kept = match_group_member (sec, kept, info);
-      if (kept != NULL
-	  && ((sec->rawsize != 0 ? sec->rawsize : sec->size)
-	      != (kept->rawsize != 0 ? kept->rawsize : kept->size)))
-	kept = NULL;
-      sec->kept_section = kept;
+      size_t alloc = flinfo->reloc_job_alloc * 2 + 16;
+
+      job = (struct elf_reloc_job *) bfd_realloc (flinfo->reloc_jobs,
+						  alloc * sizeof (*job));
+      if (job == NULL)
+	return FALSE;
+      flinfo->reloc_jobs = job;
+      flinfo->reloc_job_alloc = alloc;
+    }
+
+  job = &flinfo->reloc_jobs[flinfo->reloc_job_count];
+  memset (job, 0, sizeof (*job));
+  job->input_bfd = input_bfd;
+  job->sec = o;
+  relsize = (o->reloc_count * bed->s->int_rels_per_ext_rel
+	     * sizeof (Elf_Internal_Rela));
+  job->contents = (bfd_byte *) bfd_malloc (o->size);
+  job->relocs = (Elf_Internal_Rela *) bfd_malloc (relsize);
+  if (job->contents == NULL || job->relocs == NULL)
+    goto error_return;
+  memcpy (job->contents, contents, o->size);
+  memcpy (job->relocs, relocs, relsize);
+
+  if (flinfo->reloc_job_syms != 0)
+    {
+      struct elf_reloc_job *owner
+	= &flinfo->reloc_jobs[flinfo->reloc_job_syms - 1];
+
+      job->local_syms = owner->local_syms;
+      job->local_sections = owner->local_sections;
     }
-  return kept;
+  else if (locsymcount != 0)
+    {
+      job->local_syms = (Elf_Internal_Sym *)
+	bfd_malloc (locsymcount * sizeof (Elf_Internal_Sym));
+      job->local_sections = (asection **)
+	bfd_malloc (locsymcount * sizeof (asection *));
+      if (job->local_syms == NULL || job->local_sections == NULL)
+	{
+	  free (job->local_syms);
+	  free (job->local_sections);
+	  goto error_return;
+	}
+      memcpy (job->local_syms, isymbuf,
+	      locsymcount * sizeof (Elf_Internal_Sym));
+      memcpy (job->local_sections, flinfo->sections,
+	      locsymcount * sizeof (asection *));
+      job->own_syms = TRUE;
+      flinfo->reloc_job_syms = flinfo->reloc_job_count + 1;
+      flinfo->reloc_job_size += locsymcount * (sizeof (Elf_Internal_Sym)
+					       + sizeof (asection *));
+    }
+
+  flinfo->reloc_job_size += o->size + relsize;
+  flinfo->reloc_job_count++;
+  return TRUE;
+
+ error_return:
+  free (job->contents);
+  free (job->relocs);
+  return FALSE;
 }
 
 /* Link an input file into the linker output file.  This function
@@ -10580,6 +11993,10 @@ elf_link_input_bfd (struct elf_final_link_info *flinfo, bfd *input_bfd)
   if ((input_bfd->flags & DYNAMIC) != 0)
     return TRUE;
 
+  /* The local symbols copied for queued relocation jobs are those of
+     a previous input.  */
+  flinfo->reloc_job_syms = 0;
+
   symtab_hdr = &elf_tdata (input_bfd)->symtab_hdr;
   if (elf_bad_symtab (input_bfd))
     {
@@ -11013,6 +12430,10 @@ elf_link_input_bfd (struct elf_final_link_info *flinfo, bfd *input_bfd)
 		      && (h->root.u.def.section->owner->flags
 			  & BFD_PLUGIN) != 0)
 		    {
+		      /* Sections queued earlier must see the symbol
+			 as it was.  */
+		      if (!elf_link_run_reloc_jobs (flinfo))
+			return FALSE;
 		      h->root.type = bfd_link_hash_undefined;
 		      h->root.u.undef.abfd = h->root.u.def.section->owner;
 		    }
@@ -11051,6 +12472,10 @@ elf_link_input_bfd (struct elf_final_link_info *flinfo, bfd *input_bfd)
 			  (unsigned long) rel->r_info,
 			  (unsigned long) rel->r_offset);
 #endif
+		  /* Relocate the sections queued so far before the
+		     symbol changes.  */
+		  if (!elf_link_run_reloc_jobs (flinfo))
+		    return FALSE;
 		  if (!eval_symbol (&val, &sym_name, input_bfd, flinfo, dot,
 				    isymbuf, locsymcount, s_type == STT_SRELC))
 		    return FALSE;
@@ -11085,6 +12510,8 @@ elf_link_input_bfd (struct elf_final_link_info *flinfo, bfd *input_bfd)
 			{
 			  asection *kept;
 
+			  if (!elf_link_run_reloc_jobs (flinfo))
+			    return FALSE;
 			  kept = _bfd_elf_check_kept_section (sec,
 							      flinfo->info);
 			  if (kept != NULL)
@@ -11115,7 +12542,24 @@ elf_link_input_bfd (struct elf_final_link_info *flinfo, bfd *input_bfd)
 	     must handle STB_LOCAL/STT_SECTION symbols specially.  The
 	     output symbol is going to be a section symbol
 	     corresponding to the output section, which will require
-	     the addend to be adjusted.  */
+	     the addend to be adjusted.
+
+	     With --threads, the backend may let the section be
+	     relocated later on, in parallel with others.  */
+
+	  if (flinfo->parallel_relocs
+	      && elf_link_queue_relocs (flinfo, input_bfd, o, contents,
+					internal_relocs, isymbuf,
+					locsymcount))
+	    {
+	      bfd_size_type limit = ELF_RELOC_JOB_BYTES;
+
+	      limit *= bfd_get_max_threads ();
+	      if (flinfo->reloc_job_size >= limit
+		  && !elf_link_run_reloc_jobs (flinfo))
+		return FALSE;
+	      continue;
+	    }
 
 	  ret = (*relocate_section) (output_bfd, flinfo->info,
 				     input_bfd, o, contents,
@@ -11897,6 +13341,8 @@ elf_final_link_free (bfd *obfd, struct elf_final_link_info *flinfo)
   free (flinfo->internal_syms);
   free (flinfo->indices);
   free (flinfo->sections);
+  elf_free_reloc_jobs (flinfo);
+  free (flinfo->reloc_jobs);
   if (flinfo->symshndxbuf != (Elf_External_Sym_Shndx *) -1)
     free (flinfo->symshndxbuf);
   for (o = obfd->sections; o != NULL; o = o->next)
@@ -11981,6 +13427,16 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
   flinfo.sections = NULL;
   flinfo.symshndxbuf = NULL;
   flinfo.filesym_count = 0;
+  flinfo.parallel_relocs = (bfd_get_max_threads () > 1
+			    && bed->elf_backend_can_relocate_in_parallel
+			    && bed->elf_backend_write_section == NULL
+			    && !bfd_link_relocatable (info)
+			    && !info->emitrelocations);
+  flinfo.reloc_jobs = NULL;
+  flinfo.reloc_job_count = 0;
+  flinfo.reloc_job_alloc = 0;
+  flinfo.reloc_job_size = 0;
+  flinfo.reloc_job_syms = 0;
 
   /* The object attributes have been merged.  Remove the input
      sections from the link, and set the contents of the output
@@ -12031,6 +13487,9 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
   if (sections_removed)
     _bfd_fix_excluded_sec_syms (abfd, info);
 
+  if (info->icf)
+    elf_icf_set_output_offsets (info);
+
   /* Count up the number of relocations we will output for each output
      section, so that we know the sizes of the reloc sections.  We
      also figure out some maximum sizes.  */
@@ -12487,6 +13946,9 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
 	}
     }
 
+  if (!elf_link_run_reloc_jobs (&flinfo))
+    goto error_return;
+
   /* Free symbol buffer if needed.  */
   if (!info->reduce_memory_overheads)
     {
@@ -13326,69 +14788,192 @@ _bfd_elf_gc_mark_reloc (struct bfd_link_info *info,
   return TRUE;
 }
 
+/* A section whose references _bfd_elf_gc_mark is following, and how
+   far it has got.  */
+
+struct elf_gc_mark_frame
+{
+  asection *sec;
+  enum
+    {
+      gc_mark_group,
+      gc_mark_relocs_start,
+      gc_mark_relocs,
+      gc_mark_fdes,
+      gc_mark_eh_frame_entry,
+      gc_mark_done
+    } state;
+  /* Whether COOKIE holds the relocs of SEC.  */
+  bfd_boolean have_cookie;
+  /* The next section to look at for the current reloc, when it refers
+     to a __start_ or __stop_ symbol and all the sections of that name
+     are being marked.  */
+  asection *rsec;
+  bfd_boolean start_stop;
+  struct elf_reloc_cookie cookie;
+};
+
 /* The mark phase of garbage collection.  For a given section, mark
    it and any sections in this section's group, and all the sections
-   which define symbols to which it refers.  */
+   which define symbols to which it refers.  Sections are visited in
+   the same depth-first order as a recursive walk would use, but with
+   an explicit stack, so long chains of references don't exhaust the
+   C stack.  */
 
 bfd_boolean
 _bfd_elf_gc_mark (struct bfd_link_info *info,
 		  asection *sec,
 		  elf_gc_mark_hook_fn gc_mark_hook)
 {
+  struct elf_gc_mark_frame *stack;
+  size_t depth, alloc;
   bfd_boolean ret;
-  asection *group_sec, *eh_frame;
-
-  sec->gc_mark = 1;
 
-  /* Mark all the sections in the group.  */
-  group_sec = elf_section_data (sec)->next_in_group;
-  if (group_sec && !group_sec->gc_mark)
-    if (!_bfd_elf_gc_mark (info, group_sec, gc_mark_hook))
-      return FALSE;
+  alloc = 16;
+  stack = (struct elf_gc_mark_frame *) bfd_malloc (alloc * sizeof (*stack));
+  if (stack == NULL)
+    return FALSE;
 
-  /* Look through the section relocs.  */
+  sec->gc_mark = 1;
+  stack[0].sec = sec;
+  stack[0].state = gc_mark_group;
+  stack[0].have_cookie = FALSE;
+  stack[0].rsec = NULL;
+  depth = 1;
   ret = TRUE;
-  eh_frame = elf_eh_frame_section (sec->owner);
-  if ((sec->flags & SEC_RELOC) != 0
-      && sec->reloc_count > 0
-      && sec != eh_frame)
+
+  while (ret && depth > 0)
     {
-      struct elf_reloc_cookie cookie;
+      struct elf_gc_mark_frame *f = &stack[depth - 1];
+      asection *next = NULL;
+      asection *group_sec, *eh_frame, *rsec;
 
-      if (!init_reloc_cookie_for_section (&cookie, info, sec))
-	ret = FALSE;
-      else
+      switch (f->state)
 	{
-	  for (; cookie.rel < cookie.relend; cookie.rel++)
-	    if (!_bfd_elf_gc_mark_reloc (info, sec, gc_mark_hook, &cookie))
-	      {
+	case gc_mark_group:
+	  /* Mark all the sections in the group.  */
+	  f->state = gc_mark_relocs_start;
+	  group_sec = elf_section_data (f->sec)->next_in_group;
+	  if (group_sec && !group_sec->gc_mark)
+	    next = group_sec;
+	  break;
+
+	case gc_mark_relocs_start:
+	  /* Look through the section relocs.  */
+	  f->state = gc_mark_fdes;
+	  eh_frame = elf_eh_frame_section (f->sec->owner);
+	  if ((f->sec->flags & SEC_RELOC) != 0
+	      && f->sec->reloc_count > 0
+	      && f->sec != eh_frame)
+	    {
+	      if (!init_reloc_cookie_for_section (&f->cookie, info, f->sec))
 		ret = FALSE;
+	      else
+		{
+		  f->have_cookie = TRUE;
+		  f->state = gc_mark_relocs;
+		}
+	    }
+	  break;
+
+	case gc_mark_relocs:
+	  /* This does the job of _bfd_elf_gc_mark_reloc, one section at
+	     a time.  */
+	  if (f->rsec == NULL)
+	    {
+	      if (f->cookie.rel >= f->cookie.relend)
+		{
+		  fini_reloc_cookie_for_section (&f->cookie, f->sec);
+		  f->have_cookie = FALSE;
+		  f->state = gc_mark_fdes;
+		  break;
+		}
+	      f->start_stop = FALSE;
+	      f->rsec = _bfd_elf_gc_mark_rsec (info, f->sec, gc_mark_hook,
+					       &f->cookie, &f->start_stop);
+	      f->cookie.rel++;
+	      if (f->rsec == NULL)
 		break;
-	      }
-	  fini_reloc_cookie_for_section (&cookie, sec);
-	}
-    }
+	    }
+	  rsec = f->rsec;
+	  f->rsec = (f->start_stop
+		     ? bfd_get_next_section_by_name (rsec->owner, rsec)
+		     : NULL);
+	  if (!rsec->gc_mark)
+	    {
+	      if (bfd_get_flavour (rsec->owner) != bfd_target_elf_flavour
+		  || (rsec->owner->flags & DYNAMIC) != 0)
+		rsec->gc_mark = 1;
+	      else
+		next = rsec;
+	    }
+	  break;
 
-  if (ret && eh_frame && elf_fde_list (sec))
-    {
-      struct elf_reloc_cookie cookie;
+	case gc_mark_fdes:
+	  f->state = gc_mark_eh_frame_entry;
+	  eh_frame = elf_eh_frame_section (f->sec->owner);
+	  if (eh_frame && elf_fde_list (f->sec))
+	    {
+	      struct elf_reloc_cookie cookie;
 
-      if (!init_reloc_cookie_for_section (&cookie, info, eh_frame))
-	ret = FALSE;
-      else
+	      if (!init_reloc_cookie_for_section (&cookie, info, eh_frame))
+		ret = FALSE;
+	      else
+		{
+		  if (!_bfd_elf_gc_mark_fdes (info, f->sec, eh_frame,
+					      gc_mark_hook, &cookie))
+		    ret = FALSE;
+		  fini_reloc_cookie_for_section (&cookie, eh_frame);
+		}
+	    }
+	  break;
+
+	case gc_mark_eh_frame_entry:
+	  f->state = gc_mark_done;
+	  eh_frame = elf_section_eh_frame_entry (f->sec);
+	  if (eh_frame && !eh_frame->gc_mark)
+	    next = eh_frame;
+	  break;
+
+	case gc_mark_done:
+	  depth--;
+	  break;
+	}
+
+      if (next != NULL)
 	{
-	  if (!_bfd_elf_gc_mark_fdes (info, sec, eh_frame,
-				      gc_mark_hook, &cookie))
-	    ret = FALSE;
-	  fini_reloc_cookie_for_section (&cookie, eh_frame);
+	  if (depth == alloc)
+	    {
+	      struct elf_gc_mark_frame *n;
+
+	      alloc *= 2;
+	      n = (struct elf_gc_mark_frame *) bfd_realloc (stack,
+							   alloc
+							   * sizeof (*n));
+	      if (n == NULL)
+		{
+		  ret = FALSE;
+		  break;
+		}
+	      stack = n;
+	    }
+	  next->gc_mark = 1;
+	  stack[depth].sec = next;
+	  stack[depth].state = gc_mark_group;
+	  stack[depth].have_cookie = FALSE;
+	  stack[depth].rsec = NULL;
+	  depth++;
 	}
     }
 
-  eh_frame = elf_section_eh_frame_entry (sec);
-  if (ret && eh_frame && !eh_frame->gc_mark)
-    if (!_bfd_elf_gc_mark (info, eh_frame, gc_mark_hook))
-      ret = FALSE;
-
+  while (depth > 0)
+    {
+      depth--;
+      if (stack[depth].have_cookie)
+	fini_reloc_cookie_for_section (&stack[depth].cookie,
+				       stack[depth].sec);
+    }
+  free (stack);
   return ret;
 }
 
@@ -13810,6 +15395,207 @@ bfd_elf_parse_eh_frame_entries (bfd *abfd ATTRIBUTE_UNUSED,
   return TRUE;
 }
 
+/* The relocs of an input section, read by elf_gc_prefetch_relocs.  */
+
+struct elf_gc_prefetch_relocs
+{
+  asection *sec;
+  /* The REL and then the RELA relocs as read from the file.  */
+  bfd_byte *external;
+  Elf_Internal_Rela *internal;
+  bfd_boolean ok;
+};
+
+/* The number of sections elf_gc_prefetch_relocs reads at a time for
+   each thread.  */
+#define GC_PREFETCH_SECTIONS_PER_THREAD 16
+
+/* Swap in the relocs of HDR from EXTERNAL to INTERNAL, as
+   elf_link_read_relocs_from_section does, but without reporting
+   anything.  */
+
+static bfd_boolean
+elf_gc_swap_relocs (asection *sec, Elf_Internal_Shdr *hdr,
+		    const bfd_byte *external, Elf_Internal_Rela *internal)
+{
+  bfd *abfd = sec->owner;
+  const struct elf_backend_data *bed = get_elf_backend_data (abfd);
+  void (*swap_in) (bfd *, const bfd_byte *, Elf_Internal_Rela *);
+  size_t nsyms = NUM_SHDR_ENTRIES (&elf_tdata (abfd)->symtab_hdr);
+  const bfd_byte *end;
+
+  if (hdr->sh_entsize == bed->s->sizeof_rel)
+    swap_in = bed->s->swap_reloc_in;
+  else if (hdr->sh_entsize == bed->s->sizeof_rela)
+    swap_in = bed->s->swap_reloca_in;
+  else
+    return FALSE;
+
+  end = external + hdr->sh_size - hdr->sh_entsize;
+  for (; external <= end; external += hdr->sh_entsize)
+    {
+      bfd_vma r_symndx;
+
+      (*swap_in) (abfd, external, internal);
+      r_symndx = ELF32_R_SYM (internal->r_info);
+      if (bed->s->arch_size == 64)
+	r_symndx >>= 24;
+      if (nsyms > 0 ? (size_t) r_symndx >= nsyms : r_symndx != STN_UNDEF)
+	return FALSE;
+      internal += bed->s->int_rels_per_ext_rel;
+    }
+  return TRUE;
+}
+
+/* Swap in the relocs of the I'th section in DATA, an array of struct
+   elf_gc_prefetch_relocs.  This runs in a worker thread.  */
+
+static void
+elf_gc_swap_section_relocs (void *data, size_t i)
+{
+  struct elf_gc_prefetch_relocs *p;
+  struct bfd_elf_section_data *esd;
+  const struct elf_backend_data *bed;
+  const bfd_byte *external;
+  Elf_Internal_Rela *internal;
+
+  p = (struct elf_gc_prefetch_relocs *) data + i;
+  if (p->internal == NULL)
+    return;
+
+  esd = elf_section_data (p->sec);
+  bed = get_elf_backend_data (p->sec->owner);
+  external = p->external;
+  internal = p->internal;
+  if (esd->rel.hdr)
+    {
+      if (!elf_gc_swap_relocs (p->sec, esd->rel.hdr, external, internal))
+	return;
+      external += esd->rel.hdr->sh_size;
+      internal += (NUM_SHDR_ENTRIES (esd->rel.hdr)
+		   * bed->s->int_rels_per_ext_rel);
+    }
+  if (esd->rela.hdr
+      && !elf_gc_swap_relocs (p->sec, esd->rela.hdr, external, internal))
+    return;
+  p->ok = TRUE;
+}
+
+/* Read the relocs of the COUNT sections in RELOCS, swap them in using
+   the threads allowed by bfd_set_max_threads, and cache them as
+   _bfd_elf_link_read_relocs would with KEEP_MEMORY.  */
+
+static void
+elf_gc_prefetch_section_relocs (struct elf_gc_prefetch_relocs *relocs,
+				size_t count)
+{
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    {
+      asection *sec = relocs[i].sec;
+      bfd *sub = sec->owner;
+      struct bfd_elf_section_data *esd = elf_section_data (sec);
+      const struct elf_backend_data *bed = get_elf_backend_data (sub);
+      bfd_size_type size = 0;
+      bfd_byte *p;
+
+      relocs[i].internal = NULL;
+      relocs[i].ok = FALSE;
+      if (esd->rel.hdr)
+	size += esd->rel.hdr->sh_size;
+      if (esd->rela.hdr)
+	size += esd->rela.hdr->sh_size;
+      relocs[i].external = (bfd_byte *) bfd_malloc (size);
+      if (relocs[i].external == NULL)
+	continue;
+      p = relocs[i].external;
+      if (esd->rel.hdr)
+	{
+	  if (bfd_seek (sub, esd->rel.hdr->sh_offset, SEEK_SET) != 0
+	      || (bfd_bread (p, esd->rel.hdr->sh_size, sub)
+		  != esd->rel.hdr->sh_size))
+	    continue;
+	  p += esd->rel.hdr->sh_size;
+	}
+      if (esd->rela.hdr
+	  && (bfd_seek (sub, esd->rela.hdr->sh_offset, SEEK_SET) != 0
+	      || (bfd_bread (p, esd->rela.hdr->sh_size, sub)
+		  != esd->rela.hdr->sh_size)))
+	continue;
+      relocs[i].internal = (Elf_Internal_Rela *)
+	bfd_alloc (sub, (bfd_size_type) sec->reloc_count
+		   * bed->s->int_rels_per_ext_rel
+		   * sizeof (Elf_Internal_Rela));
+    }
+
+  bfd_parallel_for (count, elf_gc_swap_section_relocs, relocs);
+
+  /* Relocs that couldn't be read or swapped in are left for
+     _bfd_elf_link_read_relocs to report.  */
+  for (i = 0; i < count; i++)
+    {
+      if (relocs[i].ok)
+	elf_section_data (relocs[i].sec)->relocs = relocs[i].internal;
+      free (relocs[i].external);
+    }
+}
+
+/* With several threads and --keep-memory, read and swap in the relocs
+   of the allocated input sections before the mark phase starts, so
+   that it, check_relocs and the final link all use the cached copies.
+   The relocs of debug sections, which are usually the biggest, are
+   left to be read when needed.  */
+
+static void
+elf_gc_prefetch_relocs (bfd *abfd, struct bfd_link_info *info)
+{
+  const struct elf_backend_data *bed = get_elf_backend_data (abfd);
+  struct elf_gc_prefetch_relocs *relocs;
+  size_t batch, count;
+  bfd *sub;
+
+  if (bfd_get_max_threads () < 2 || !info->keep_memory)
+    return;
+
+  batch = bfd_get_max_threads () * GC_PREFETCH_SECTIONS_PER_THREAD;
+  relocs = (struct elf_gc_prefetch_relocs *)
+    bfd_malloc (batch * sizeof (*relocs));
+  if (relocs == NULL)
+    return;
+
+  count = 0;
+  for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+    {
+      asection *o;
+
+      if (bfd_get_flavour (sub) != bfd_target_elf_flavour
+	  || elf_object_id (sub) != elf_hash_table_id (elf_hash_table (info))
+	  || !(*bed->relocs_compatible) (sub->xvec, abfd->xvec))
+	continue;
+
+      o = sub->sections;
+      if (o == NULL || o->sec_info_type == SEC_INFO_TYPE_JUST_SYMS)
+	continue;
+
+      for (; o != NULL; o = o->next)
+	if ((o->flags & (SEC_ALLOC | SEC_RELOC | SEC_EXCLUDE))
+	    == (SEC_ALLOC | SEC_RELOC)
+	    && o->reloc_count > 0
+	    && elf_section_data (o)->relocs == NULL)
+	  {
+	    relocs[count++].sec = o;
+	    if (count == batch)
+	      {
+		elf_gc_prefetch_section_relocs (relocs, count);
+		count = 0;
+	      }
+	  }
+    }
+  elf_gc_prefetch_section_relocs (relocs, count);
+  free (relocs);
+}
+
 /* Do mark and sweep of unused sections.  */
 
 bfd_boolean
@@ -13831,6 +15617,8 @@ bfd_elf_gc_sections (bfd *abfd, struct bfd_link_info *info)
   bed->gc_keep (info);
   htab = elf_hash_table (info);
 
+  elf_gc_prefetch_relocs (abfd, info);
+
   /* Try to parse each bfd's .eh_frame section.  Point elf_eh_frame_section
      at the .eh_frame section if we can mark the FDEs individually.  */
   for (sub = info->input_bfds;
@@ -498,6 +498,9 @@
 #ifndef elf_backend_relocate_section
 #define elf_backend_relocate_section	0
 #endif
+#ifndef elf_backend_can_relocate_in_parallel
+#define elf_backend_can_relocate_in_parallel	NULL
+#endif
 #ifndef elf_backend_finish_dynamic_symbol
 #define elf_backend_finish_dynamic_symbol	0
 #endif
@@ -842,6 +845,7 @@ static struct elf_backend_data elfNN_bed =
   elf_backend_strip_zero_sized_dynamic_sections,
   elf_backend_init_index_section,
   elf_backend_relocate_section,
+  elf_backend_can_relocate_in_parallel,
   elf_backend_finish_dynamic_symbol,
   elf_backend_finish_dynamic_sections,
   elf_backend_begin_write_processing,
@@ -63,7 +63,10 @@ _bfd_x86_elf_set_tls_module_base (struct bfd_link_info *info)
   if (base == NULL)
     return;
 
-  base->u.def.value = htab->elf.tls_size;
+  /* This is called for each section relocated, possibly from several
+     threads at once.  Only write the value if it changes.  */
+  if (base->u.def.value != htab->elf.tls_size)
+    base->u.def.value = htab->elf.tls_size;
 }
 
 /* Return the base VMA address which should be subtracted from real addresses
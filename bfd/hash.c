@@ -92,6 +92,16 @@ SUBSECTION
 	Use <<bfd_hash_set_default_size>> to set the default size of
 	hash table to use.
 
+@findex bfd_hash_table_open_addressing
+	By default each slot of a hash table holds a chain of entries.
+	Calling <<bfd_hash_table_open_addressing>> on a newly created
+	table, before any entries are added to it, switches it to open
+	addressing, where each slot holds at most one entry and a byte
+	of its hash value.  That is faster for large tables which are
+	mostly looked up, such as the linker symbol table.  Code which
+	walks the <<table>> array and the <<next>> chains of the
+	entries directly works with either kind of table.
+
 INODE
 Looking Up or Entering a String, Traversing a Hash Table, Creating and Freeing a Hash Table, Hash Tables
 SUBSECTION
@@ -400,7 +410,9 @@ bfd_hash_table_init_n (struct bfd_hash_table *table,
   table->size = size;
   table->entsize = entsize;
   table->count = 0;
+  table->deleted = 0;
   table->frozen = 0;
+  table->open_addressing = 0;
   table->newfunc = newfunc;
   return TRUE;
 }
@@ -452,6 +464,262 @@ bfd_hash_hash (const char *string, unsigned int *lenp)
   return hash;
 }
 
+/* An open addressed table has SIZE entry pointers in TABLE, followed
+   by SIZE tag bytes.  A zero tag marks an empty slot and OA_DELETED a
+   slot freed by bfd_hash_rename.  The tag of a used slot is OA_USED
+   plus seven bits of the entry's hash, so that a probe can compare
+   the tags of a group of OA_GROUP slots at once and rarely needs to
+   look at an entry which doesn't match.  Entries are placed in the
+   first group along their probe sequence that has a free slot, so a
+   search can stop at the first group with an empty slot.  */
+
+#define OA_GROUP 8
+#define OA_DELETED 0x01
+#define OA_USED 0x80
+#define OA_MIN_SIZE 64
+
+#define OA_ONES ((((uint64_t) 0x01010101) << 32) | 0x01010101)
+#define OA_HIGHS (OA_ONES * 0x80)
+
+static inline unsigned char *
+oa_tags (const struct bfd_hash_table *table)
+{
+  return (unsigned char *) (table->table + table->size);
+}
+
+/* The low bits of bfd_hash_hash aren't well mixed, which doesn't
+   matter for a prime table size but does for a power of two.  */
+
+static inline unsigned int
+oa_mix (unsigned long hash)
+{
+  unsigned int mix = (unsigned int) hash * 0x9e3779b1U;
+
+  return mix ^ (mix >> 15);
+}
+
+static inline unsigned char
+oa_tag (unsigned int mix)
+{
+  return OA_USED | (mix >> 25);
+}
+
+/* Read the tags of the group at P so that slot I is in byte I counting
+   from the least significant end, whatever the host byte order.  */
+
+static inline uint64_t
+oa_group (const unsigned char *p)
+{
+  return ((uint64_t) p[0]
+	  | ((uint64_t) p[1] << 8)
+	  | ((uint64_t) p[2] << 16)
+	  | ((uint64_t) p[3] << 24)
+	  | ((uint64_t) p[4] << 32)
+	  | ((uint64_t) p[5] << 40)
+	  | ((uint64_t) p[6] << 48)
+	  | ((uint64_t) p[7] << 56));
+}
+
+/* Return a mask with the top bit of each byte of GROUP that may be
+   equal to TAG set.  The lowest bit set is always a real match, but
+   bytes above a match can be reported falsely, so callers recheck.  */
+
+static inline uint64_t
+oa_match (uint64_t group, unsigned char tag)
+{
+  uint64_t x = group ^ (OA_ONES * tag);
+
+  return (x - OA_ONES) & ~x & OA_HIGHS;
+}
+
+/* Return the slot in its group of the lowest bit set in MASK.  */
+
+static inline unsigned int
+oa_first (uint64_t mask)
+{
+#if GCC_VERSION >= 3004
+  return __builtin_ctzll (mask) / 8;
+#else
+  unsigned int i;
+
+  for (i = 0; (mask & 0x80) == 0; i++)
+    mask >>= 8;
+  return i;
+#endif
+}
+
+/* Look for an entry for STRING, which hashes to HASH, in the open
+   addressed TABLE.  */
+
+static struct bfd_hash_entry *
+oa_lookup (struct bfd_hash_table *table,
+	   const char *string,
+	   unsigned long hash)
+{
+  unsigned char *tags = oa_tags (table);
+  unsigned int mask = table->size - 1;
+  unsigned int mix = oa_mix (hash);
+  unsigned char tag = oa_tag (mix);
+  unsigned int group = mix & mask & ~(OA_GROUP - 1);
+  unsigned int probes;
+
+  for (probes = 0; probes < table->size / OA_GROUP; probes++)
+    {
+      uint64_t g;
+      uint64_t m;
+
+#if GCC_VERSION >= 3001
+      /* Start fetching the slots while the tags are compared.  */
+      __builtin_prefetch (table->table + group);
+#endif
+      g = oa_group (tags + group);
+      for (m = oa_match (g, tag); m != 0; m &= m - 1)
+	{
+	  unsigned int i = group + oa_first (m);
+	  struct bfd_hash_entry *hashp = table->table[i];
+
+	  if (tags[i] == tag
+	      && hashp->hash == hash
+	      && strcmp (hashp->string, string) == 0)
+	    return hashp;
+	}
+      if (oa_match (g, 0) != 0)
+	break;
+      group = (group + OA_GROUP) & mask;
+    }
+  return NULL;
+}
+
+/* Return the slot in which an entry hashing to HASH should be placed
+   in the open addressed table with SIZE slots and tags TAGS.  */
+
+static unsigned int
+oa_free_slot (const unsigned char *tags, unsigned int size,
+	      unsigned long hash)
+{
+  unsigned int mask = size - 1;
+  unsigned int group = oa_mix (hash) & mask & ~(OA_GROUP - 1);
+
+  for (;;)
+    {
+      uint64_t m = ~oa_group (tags + group) & OA_HIGHS;
+
+      if (m != 0)
+	return group + oa_first (m);
+      group = (group + OA_GROUP) & mask;
+    }
+}
+
+/* Return the slot holding ENT in the open addressed TABLE.  */
+
+static unsigned int
+oa_slot (struct bfd_hash_table *table, struct bfd_hash_entry *ent)
+{
+  unsigned char *tags = oa_tags (table);
+  unsigned int mask = table->size - 1;
+  unsigned int mix = oa_mix (ent->hash);
+  unsigned char tag = oa_tag (mix);
+  unsigned int group = mix & mask & ~(OA_GROUP - 1);
+  unsigned int probes;
+
+  for (probes = 0; probes < table->size / OA_GROUP; probes++)
+    {
+      uint64_t g = oa_group (tags + group);
+      uint64_t m;
+
+      for (m = oa_match (g, tag); m != 0; m &= m - 1)
+	{
+	  unsigned int i = group + oa_first (m);
+
+	  if (table->table[i] == ent)
+	    return i;
+	}
+      if (oa_match (g, 0) != 0)
+	break;
+      group = (group + OA_GROUP) & mask;
+    }
+  abort ();
+}
+
+/* Allocate SIZE slots for the open addressed TABLE and move its
+   entries there.  */
+
+static bfd_boolean
+oa_resize (struct bfd_hash_table *table, unsigned int size)
+{
+  struct bfd_hash_entry **newtable;
+  unsigned char *newtags;
+  unsigned long alloc;
+  unsigned int i;
+
+  alloc = (unsigned long) size * (sizeof (struct bfd_hash_entry *) + 1);
+  if (size < table->size
+      || alloc / (sizeof (struct bfd_hash_entry *) + 1) != size)
+    return FALSE;
+
+  newtable = ((struct bfd_hash_entry **)
+	      objalloc_alloc ((struct objalloc *) table->memory, alloc));
+  if (newtable == NULL)
+    return FALSE;
+  memset (newtable, 0, alloc);
+  newtags = (unsigned char *) (newtable + size);
+
+  if (table->open_addressing)
+    {
+      unsigned char *tags = oa_tags (table);
+
+      for (i = 0; i < table->size; i++)
+	if (tags[i] >= OA_USED)
+	  {
+	    struct bfd_hash_entry *hashp = table->table[i];
+	    unsigned int slot = oa_free_slot (newtags, size, hashp->hash);
+
+	    newtable[slot] = hashp;
+	    newtags[slot] = tags[i];
+	  }
+    }
+
+  table->table = newtable;
+  table->size = size;
+  table->deleted = 0;
+  return TRUE;
+}
+
+/* Insert HASHP, whose hash is already set, in the open addressed
+   TABLE.  */
+
+static void
+oa_insert (struct bfd_hash_table *table, struct bfd_hash_entry *hashp)
+{
+  unsigned char *tags = oa_tags (table);
+  unsigned int slot = oa_free_slot (tags, table->size, hashp->hash);
+
+  if (tags[slot] == OA_DELETED)
+    table->deleted--;
+  hashp->next = NULL;
+  table->table[slot] = hashp;
+  tags[slot] = oa_tag (oa_mix (hashp->hash));
+}
+
+/* Make the empty hash TABLE use open addressing.  */
+
+bfd_boolean
+bfd_hash_table_open_addressing (struct bfd_hash_table *table)
+{
+  unsigned int size;
+
+  BFD_ASSERT (table->count == 0 && !table->open_addressing);
+  for (size = OA_MIN_SIZE; size < table->size && size <= ~0U / 2; size *= 2)
+    ;
+  if (!oa_resize (table, size))
+    {
+      bfd_set_error (bfd_error_no_memory);
+      return FALSE;
+    }
+  table->open_addressing = 1;
+  return TRUE;
+}
+
 /* Look up a string in a hash table.  */
 
 struct bfd_hash_entry *
@@ -466,15 +734,24 @@ bfd_hash_lookup (struct bfd_hash_table *table,
   unsigned int _index;
 
   hash = bfd_hash_hash (string, &len);
-  _index = hash % table->size;
-  for (hashp = table->table[_index];
-       hashp != NULL;
-       hashp = hashp->next)
+  if (table->open_addressing)
     {
-      if (hashp->hash == hash
-	  && strcmp (hashp->string, string) == 0)
+      hashp = oa_lookup (table, string, hash);
+      if (hashp != NULL)
 	return hashp;
     }
+  else
+    {
+      _index = hash % table->size;
+      for (hashp = table->table[_index];
+	   hashp != NULL;
+	   hashp = hashp->next)
+	{
+	  if (hashp->hash == hash
+	      && strcmp (hashp->string, string) == 0)
+	    return hashp;
+	}
+    }
 
   if (! create)
     return NULL;
@@ -507,6 +784,35 @@ bfd_hash_insert (struct bfd_hash_table *table,
   struct bfd_hash_entry *hashp;
   unsigned int _index;
 
+  if (table->open_addressing)
+    {
+      /* Keep at least a quarter of the slots empty, so that probes
+	 stay short and always end.  */
+      if (table->count + table->deleted >= table->size / 4 * 3)
+	{
+	  if (table->frozen
+	      || table->size > ~0U / 2
+	      || !oa_resize (table, table->size * 2))
+	    {
+	      /* A frozen table is being traversed, so it can't move.  */
+	      if (table->count + table->deleted >= table->size - 1)
+		{
+		  bfd_set_error (bfd_error_no_memory);
+		  return NULL;
+		}
+	    }
+	}
+
+      hashp = (*table->newfunc) (NULL, table, string);
+      if (hashp == NULL)
+	return NULL;
+      hashp->string = string;
+      hashp->hash = hash;
+      oa_insert (table, hashp);
+      table->count++;
+      return hashp;
+    }
+
   hashp = (*table->newfunc) (NULL, table, string);
   if (hashp == NULL)
     return NULL;
@@ -572,6 +878,18 @@ bfd_hash_rename (struct bfd_hash_table *table,
   unsigned int _index;
   struct bfd_hash_entry **pph;
 
+  if (table->open_addressing)
+    {
+      _index = oa_slot (table, ent);
+      table->table[_index] = NULL;
+      oa_tags (table)[_index] = OA_DELETED;
+      table->deleted++;
+      ent->string = string;
+      ent->hash = bfd_hash_hash (string, NULL);
+      oa_insert (table, ent);
+      return;
+    }
+
   _index = ent->hash % table->size;
   for (pph = &table->table[_index]; *pph != NULL; pph = &(*pph)->next)
     if (*pph == ent)
@@ -597,6 +915,12 @@ bfd_hash_replace (struct bfd_hash_table *table,
   unsigned int _index;
   struct bfd_hash_entry **pph;
 
+  if (table->open_addressing)
+    {
+      table->table[oa_slot (table, old)] = nw;
+      return;
+    }
+
   _index = old->hash % table->size;
   for (pph = &table->table[_index];
        (*pph) != NULL;
@@ -610,6 +610,10 @@ extern bfd_boolean _bfd_dwarf2_slurp_debug_info
 extern void _bfd_dwarf2_cleanup_debug_info
   (bfd *, void **) ATTRIBUTE_HIDDEN;
 
+/* Compress several output sections, possibly in parallel.  */
+extern bfd_boolean _bfd_compress_sections
+  (bfd *, unsigned int, asection **, bfd_byte **) ATTRIBUTE_HIDDEN;
+
 /* Create a new section entry.  */
 extern struct bfd_hash_entry *bfd_section_hash_newfunc
   (struct bfd_hash_entry *, struct bfd_hash_table *, const char *)
@@ -22,6 +22,9 @@
 #include "sysdep.h"
 #include "bfd.h"
 #include "libbfd.h"
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
 
 #ifndef HAVE_GETPAGESIZE
 #define getpagesize() 2048
@@ -1018,6 +1021,202 @@ bfd_log2 (bfd_vma x)
   return result;
 }
 
+/* The number of threads BFD may use, including the calling one.  */
+
+static unsigned int bfd_max_threads = 1;
+
+/*
+FUNCTION
+	bfd_set_max_threads
+
+SYNOPSIS
+	void bfd_set_max_threads (unsigned int count);
+
+DESCRIPTION
+	Let BFD use up to @var{count} threads, including the calling
+	one, for work that it can split up, such as compressing
+	several sections.  A @var{count} of zero means as many
+	threads as there are processors online.  The default is one.
+	This has no effect on hosts without POSIX threads.
+*/
+
+void
+bfd_set_max_threads (unsigned int count)
+{
+#ifdef HAVE_PTHREAD
+  if (count == 0)
+    {
+#if defined (HAVE_SYSCONF) && defined (_SC_NPROCESSORS_ONLN)
+      long online = sysconf (_SC_NPROCESSORS_ONLN);
+
+      count = online > 0 ? (unsigned int) online : 1;
+#else
+      count = 1;
+#endif
+    }
+  bfd_max_threads = count;
+#else
+  (void) count;
+#endif
+}
+
+/*
+FUNCTION
+	bfd_get_max_threads
+
+SYNOPSIS
+	unsigned int bfd_get_max_threads (void);
+
+DESCRIPTION
+	Return the number of threads BFD may use, as set by
+	<<bfd_set_max_threads>>.
+*/
+
+unsigned int
+bfd_get_max_threads (void)
+{
+  return bfd_max_threads;
+}
+
+/*
+FUNCTION
+	bfd_parallel_for
+
+SYNOPSIS
+	void bfd_parallel_for
+	  (size_t count, void (*func) (void *, size_t), void *data);
+
+DESCRIPTION
+	Call @var{func} with @var{data} and each index from zero to
+	@var{count} - 1, spreading the calls over the threads allowed
+	by <<bfd_set_max_threads>>, and return once all of them are
+	done.  Calls for different indices may run concurrently and in
+	any order, so @var{func} must only touch data private to its
+	index, and must not do I/O on a BFD, allocate on a BFD's
+	objalloc, or set <<bfd_error>>.
+*/
+
+#ifdef HAVE_PTHREAD
+struct parallel_for_state
+{
+  pthread_mutex_t lock;
+  size_t next;
+  size_t count;
+  void (*func) (void *, size_t);
+  void *data;
+};
+
+static void *
+parallel_for_worker (void *arg)
+{
+  struct parallel_for_state *state = (struct parallel_for_state *) arg;
+
+  for (;;)
+    {
+      size_t i;
+
+      pthread_mutex_lock (&state->lock);
+      i = state->next;
+      if (i < state->count)
+	state->next++;
+      pthread_mutex_unlock (&state->lock);
+
+      if (i >= state->count)
+	break;
+      state->func (state->data, i);
+    }
+  return NULL;
+}
+#endif
+
+void
+bfd_parallel_for (size_t count, void (*func) (void *, size_t), void *data)
+{
+  size_t i;
+
+#ifdef HAVE_PTHREAD
+  if (bfd_max_threads > 1 && count > 1)
+    {
+      struct parallel_for_state state;
+      size_t nthreads = bfd_max_threads < count ? bfd_max_threads : count;
+      pthread_t *threads;
+      size_t started = 0;
+
+      threads = (pthread_t *) bfd_malloc ((nthreads - 1) * sizeof (*threads));
+      if (threads != NULL
+	  && pthread_mutex_init (&state.lock, NULL) == 0)
+	{
+	  state.next = 0;
+	  state.count = count;
+	  state.func = func;
+	  state.data = data;
+
+	  /* If some threads can't be created, make do with fewer.  */
+	  while (started < nthreads - 1
+		 && pthread_create (&threads[started], NULL,
+				    parallel_for_worker, &state) == 0)
+	    started++;
+
+	  parallel_for_worker (&state);
+	  for (i = 0; i < started; i++)
+	    pthread_join (threads[i], NULL);
+
+	  pthread_mutex_destroy (&state.lock);
+	  free (threads);
+	  return;
+	}
+      free (threads);
+    }
+#endif
+
+  for (i = 0; i < count; i++)
+    func (data, i);
+}
+
+#ifdef HAVE_PTHREAD
+static pthread_mutex_t parallel_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/*
+INTERNAL_FUNCTION
+	_bfd_parallel_lock
+
+SYNOPSIS
+	void _bfd_parallel_lock (void);
+
+DESCRIPTION
+	Take the lock that serializes the rare updates that functions
+	run by <<bfd_parallel_for>> must make to data shared between
+	indices.  Release it with <<_bfd_parallel_unlock>>.
+*/
+
+void
+_bfd_parallel_lock (void)
+{
+#ifdef HAVE_PTHREAD
+  pthread_mutex_lock (&parallel_lock);
+#endif
+}
+
+/*
+INTERNAL_FUNCTION
+	_bfd_parallel_unlock
+
+SYNOPSIS
+	void _bfd_parallel_unlock (void);
+
+DESCRIPTION
+	Release the lock taken by <<_bfd_parallel_lock>>.
+*/
+
+void
+_bfd_parallel_unlock (void)
+{
+#ifdef HAVE_PTHREAD
+  pthread_mutex_unlock (&parallel_lock);
+#endif
+}
+
 bfd_boolean
 bfd_generic_is_local_label_name (bfd *abfd, const char *name)
 {
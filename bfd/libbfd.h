@@ -615,6 +615,10 @@ extern bfd_boolean _bfd_dwarf2_slurp_debug_info
 extern void _bfd_dwarf2_cleanup_debug_info
   (bfd *, void **) ATTRIBUTE_HIDDEN;
 
+/* Compress several output sections, possibly in parallel.  */
+extern bfd_boolean _bfd_compress_sections
+  (bfd *, unsigned int, asection **, bfd_byte **) ATTRIBUTE_HIDDEN;
+
 /* Create a new section entry.  */
 extern struct bfd_hash_entry *bfd_section_hash_newfunc
   (struct bfd_hash_entry *, struct bfd_hash_table *, const char *)
@@ -966,6 +970,10 @@ bfd_boolean bfd_write_bigendian_4byte_int (bfd *, unsigned int);
 
 unsigned int bfd_log2 (bfd_vma x);
 
+void _bfd_parallel_lock (void);
+
+void _bfd_parallel_unlock (void);
+
 /* Extracted from bfdio.c.  */
 struct bfd_iovec
 {
@@ -96,7 +96,10 @@ struct sec_merge_sec_info
   /* First string in this section.  */
   struct sec_merge_hash_entry *first_str;
   /* Original section content.  */
-  unsigned char contents[1];
+  unsigned char *contents;
+  /* The view holding CONTENTS, unless they were copied to add a
+     terminator.  */
+  bfd_window view;
 };
 
 
@@ -131,18 +134,18 @@ sec_merge_hash_newfunc (struct bfd_hash_entry *entry,
   return entry;
 }
 
-/* Look up an entry in a section merge hash table.  */
+/* Return the hash of the entity at STRING in TABLE, and store its
+   length, including the terminator of a string, in *LENP.  This
+   doesn't change TABLE, so it may be called from worker threads.  */
 
-static struct sec_merge_hash_entry *
-sec_merge_hash_lookup (struct sec_merge_hash *table, const char *string,
-		       unsigned int alignment, bfd_boolean create)
+static unsigned long
+sec_merge_hash_string (const struct sec_merge_hash *table,
+		       const char *string, unsigned int *lenp)
 {
   const unsigned char *s;
   unsigned long hash;
   unsigned int c;
-  struct sec_merge_hash_entry *hashp;
   unsigned int len, i;
-  unsigned int _index;
 
   hash = 0;
   len = 0;
@@ -193,6 +196,21 @@ sec_merge_hash_lookup (struct sec_merge_hash *table, const char *string,
       len = table->entsize;
     }
 
+  *lenp = len;
+  return hash;
+}
+
+/* Look up an entry in a section merge hash table.  STRING is LEN
+   octets long and has hash HASH, as given by sec_merge_hash_string.  */
+
+static struct sec_merge_hash_entry *
+sec_merge_hash_lookup (struct sec_merge_hash *table, const char *string,
+		       unsigned long hash, unsigned int len,
+		       unsigned int alignment, bfd_boolean create)
+{
+  struct sec_merge_hash_entry *hashp;
+  unsigned int _index;
+
   _index = hash % table->table.size;
   for (hashp = (struct sec_merge_hash_entry *) table->table.table[_index];
        hashp != NULL;
@@ -262,11 +280,12 @@ sec_merge_init (unsigned int entsize, bfd_boolean strings)
 
 static struct sec_merge_hash_entry *
 sec_merge_add (struct sec_merge_hash *tab, const char *str,
+	       unsigned long hash, unsigned int len,
 	       unsigned int alignment, struct sec_merge_sec_info *secinfo)
 {
   struct sec_merge_hash_entry *entry;
 
-  entry = sec_merge_hash_lookup (tab, str, alignment, TRUE);
+  entry = sec_merge_hash_lookup (tab, str, hash, len, alignment, TRUE);
   if (entry == NULL)
     return NULL;
 
@@ -435,15 +454,7 @@ _bfd_add_merge_section (bfd *abfd, void **psinfo, asection *sec,
 	goto error_return;
     }
 
-  /* Read the section from abfd.  */
-
-  amt = sizeof (struct sec_merge_sec_info) - 1 + sec->size;
-  if (sec->flags & SEC_STRINGS)
-    /* Some versions of gcc may emit a string without a zero terminator.
-       See http://gcc.gnu.org/ml/gcc-patches/2006-06/msg01004.html
-       Allocate space for an extra zero.  */
-    amt += sec->entsize;
-  *psecinfo = bfd_alloc (abfd, amt);
+  *psecinfo = bfd_alloc (abfd, sizeof (struct sec_merge_sec_info));
   if (*psecinfo == NULL)
     goto error_return;
 
@@ -460,13 +471,35 @@ _bfd_add_merge_section (bfd *abfd, void **psinfo, asection *sec,
   secinfo->psecinfo = psecinfo;
   secinfo->htab = sinfo->htab;
   secinfo->first_str = NULL;
+  bfd_init_window (&secinfo->view);
 
+  /* Read the section from abfd.  The contents are kept until
+     _bfd_merge_sections_free, so mapping them from the file where
+     possible saves memory.  */
   sec->rawsize = sec->size;
-  if (sec->flags & SEC_STRINGS)
-    memset (secinfo->contents + sec->size, 0, sec->entsize);
-  contents = secinfo->contents;
-  if (! bfd_get_full_section_contents (sec->owner, sec, &contents))
+  if (! bfd_get_full_section_contents_view (sec->owner, sec, &secinfo->view))
     goto error_return;
+  secinfo->contents = (unsigned char *) secinfo->view.data;
+
+  if (sec->flags & SEC_STRINGS)
+    {
+      /* Some versions of gcc may emit a string without a zero terminator.
+	 See http://gcc.gnu.org/ml/gcc-patches/2006-06/msg01004.html
+	 Copy the contents with an extra zero.  */
+      for (amt = sec->size - sec->entsize; amt < sec->size; amt++)
+	if (secinfo->contents[amt] != 0)
+	  break;
+      if (amt != sec->size)
+	{
+	  contents = (bfd_byte *) bfd_alloc (abfd, sec->size + sec->entsize);
+	  if (contents == NULL)
+	    goto error_return;
+	  memcpy (contents, secinfo->contents, sec->size);
+	  memset (contents + sec->size, 0, sec->entsize);
+	  bfd_free_window (&secinfo->view);
+	  secinfo->contents = contents;
+	}
+    }
 
   return TRUE;
 
@@ -475,17 +508,92 @@ _bfd_add_merge_section (bfd *abfd, void **psinfo, asection *sec,
   return FALSE;
 }
 
-/* Record one section into the hash table.  */
+/* A string or constant of a SEC_MERGE section, hashed before it is
+   entered into the hash table.  */
+
+struct sec_merge_piece
+{
+  /* The entity, in the section contents.  */
+  const char *str;
+  /* Its hash and length, as given by sec_merge_hash_string.  */
+  unsigned long hash;
+  unsigned int len;
+  /* The alignment it needs.  */
+  unsigned int alignment;
+};
+
+/* The pieces of one section, as found by split_section.  */
+
+struct sec_merge_split
+{
+  struct sec_merge_sec_info *secinfo;
+  struct sec_merge_piece *pieces;
+  size_t count;
+  size_t alloc;
+  /* Whether the pieces are entered into the hash table as they are
+     found, rather than saved in PIECES.  */
+  bfd_boolean direct;
+  /* Whether all of the section was split.  */
+  bfd_boolean ok;
+};
+
+/* The number of sections, and of bytes of their contents, that
+   _bfd_merge_sections splits at a time for each thread.  The pieces
+   take a few times the size of the contents, so bigger sections are
+   recorded directly.  */
+#define MERGE_SECTIONS_PER_THREAD 4
+#define MERGE_BYTES_PER_THREAD (4 * 1024 * 1024)
+
+/* Add the entity at STR, which needs ALIGNMENT, to the pieces of
+   SPLIT, and set *PLEN to its length.  */
+
 static bfd_boolean
-record_section (struct sec_merge_info *sinfo,
-		struct sec_merge_sec_info *secinfo)
+add_piece (struct sec_merge_split *split, const char *str,
+	   unsigned int alignment, unsigned int *plen)
 {
+  struct sec_merge_piece *piece;
+  unsigned long hash;
+
+  hash = sec_merge_hash_string (split->secinfo->htab, str, plen);
+  if (split->direct)
+    return sec_merge_add (split->secinfo->htab, str, hash, *plen,
+			  alignment, split->secinfo) != NULL;
+
+  if (split->count == split->alloc)
+    {
+      size_t alloc = split->alloc ? split->alloc * 2 : 64;
+
+      /* Plain realloc, since this runs in worker threads.  */
+      piece = (struct sec_merge_piece *) realloc (split->pieces,
+						  alloc * sizeof (*piece));
+      if (piece == NULL)
+	return FALSE;
+      split->pieces = piece;
+      split->alloc = alloc;
+    }
+
+  piece = split->pieces + split->count++;
+  piece->str = str;
+  piece->hash = hash;
+  piece->len = *plen;
+  piece->alignment = alignment;
+  return TRUE;
+}
+
+/* Split the contents of the I'th section in DATA, an array of struct
+   sec_merge_split, into the entities to be merged, and hash them.
+   This runs in a worker thread, unless the split is direct.  */
+
+static void
+split_section (void *data, size_t idx)
+{
+  struct sec_merge_split *split = (struct sec_merge_split *) data + idx;
+  struct sec_merge_sec_info *secinfo = split->secinfo;
   asection *sec = secinfo->sec;
-  struct sec_merge_hash_entry *entry;
   bfd_boolean nul;
   unsigned char *p, *end;
   bfd_vma mask, eltalign;
-  unsigned int align, i;
+  unsigned int align, i, len;
 
   align = sec->alignment_power;
   end = secinfo->contents + sec->size;
@@ -499,11 +607,9 @@ record_section (struct sec_merge_info *sinfo,
 	  eltalign = ((eltalign ^ (eltalign - 1)) + 1) >> 1;
 	  if (!eltalign || eltalign > mask)
 	    eltalign = mask + 1;
-	  entry = sec_merge_add (sinfo->htab, (char *) p, (unsigned) eltalign,
-				 secinfo);
-	  if (! entry)
-	    goto error_return;
-	  p += entry->len;
+	  if (!add_piece (split, (char *) p, (unsigned) eltalign, &len))
+	    return;
+	  p += len;
 	  if (sec->entsize == 1)
 	    {
 	      while (p < end && *p == 0)
@@ -511,10 +617,8 @@ record_section (struct sec_merge_info *sinfo,
 		  if (!nul && !((p - secinfo->contents) & mask))
 		    {
 		      nul = TRUE;
-		      entry = sec_merge_add (sinfo->htab, "",
-					     (unsigned) mask + 1, secinfo);
-		      if (! entry)
-			goto error_return;
+		      if (!add_piece (split, "", (unsigned) mask + 1, &len))
+			return;
 		    }
 		  p++;
 		}
@@ -531,10 +635,9 @@ record_section (struct sec_merge_info *sinfo,
 		  if (!nul && !((p - secinfo->contents) & mask))
 		    {
 		      nul = TRUE;
-		      entry = sec_merge_add (sinfo->htab, (char *) p,
-					     (unsigned) mask + 1, secinfo);
-		      if (! entry)
-			goto error_return;
+		      if (!add_piece (split, (char *) p, (unsigned) mask + 1,
+				      &len))
+			return;
 		    }
 		  p += sec->entsize;
 		}
@@ -544,11 +647,57 @@ record_section (struct sec_merge_info *sinfo,
   else
     {
       for (p = secinfo->contents; p < end; p += sec->entsize)
-	{
-	  entry = sec_merge_add (sinfo->htab, (char *) p, 1, secinfo);
-	  if (! entry)
-	    goto error_return;
-	}
+	if (!add_piece (split, (char *) p, 1, &len))
+	  return;
+    }
+
+  split->ok = TRUE;
+}
+
+/* Record one section into the hash table, splitting it in the
+   calling thread.  */
+
+static bfd_boolean
+record_section (struct sec_merge_info *sinfo,
+		struct sec_merge_sec_info *secinfo)
+{
+  struct sec_merge_split split;
+
+  memset (&split, 0, sizeof (split));
+  split.secinfo = secinfo;
+  split.direct = TRUE;
+  split_section (&split, 0);
+  if (split.ok)
+    return TRUE;
+
+  for (secinfo = sinfo->chain; secinfo; secinfo = secinfo->next)
+    *secinfo->psecinfo = NULL;
+  return FALSE;
+}
+
+/* Record one section, as split by split_section, into the hash
+   table.  */
+
+static bfd_boolean
+record_split (struct sec_merge_info *sinfo,
+	      struct sec_merge_split *split)
+{
+  struct sec_merge_sec_info *secinfo;
+  size_t i;
+
+  if (!split->ok)
+    {
+      bfd_set_error (bfd_error_no_memory);
+      goto error_return;
+    }
+
+  for (i = 0; i < split->count; i++)
+    {
+      struct sec_merge_piece *piece = split->pieces + i;
+
+      if (! sec_merge_add (sinfo->htab, piece->str, piece->hash, piece->len,
+			   piece->alignment, split->secinfo))
+	goto error_return;
     }
 
   return TRUE;
@@ -559,6 +708,26 @@ record_section (struct sec_merge_info *sinfo,
   return FALSE;
 }
 
+/* Split the COUNT sections of SPLITS in worker threads, then record
+   them into the hash table in order.  */
+
+static bfd_boolean
+record_splits (struct sec_merge_info *sinfo,
+	       struct sec_merge_split *splits, size_t count)
+{
+  bfd_boolean ok = TRUE;
+  size_t i;
+
+  bfd_parallel_for (count, split_section, splits);
+  for (i = 0; i < count; i++)
+    {
+      if (ok && !record_split (sinfo, &splits[i]))
+	ok = FALSE;
+      free (splits[i].pieces);
+    }
+  return ok;
+}
+
 /* qsort comparison function.  Won't ever return zero as all entries
    differ, so there is no issue with qsort stability here.  */
 
@@ -626,6 +795,118 @@ is_suffix (const struct sec_merge_hash_entry *A,
 		 B->root.string, B->len) == 0;
 }
 
+/* State for sort_strings.  */
+
+struct sec_merge_sort
+{
+  /* The entries, and a buffer of the same size to merge into.  */
+  struct sec_merge_hash_entry **array;
+  struct sec_merge_hash_entry **tmp;
+  /* The start of each run of ARRAY, and its end.  */
+  size_t *bounds;
+  size_t nruns;
+  /* The number of runs merged into each half of a merge_runs job.  */
+  size_t width;
+  int (*cmp) (const void *, const void *);
+};
+
+/* Sort the I'th run of the sec_merge_sort DATA.  */
+
+static void
+sort_run (void *data, size_t i)
+{
+  struct sec_merge_sort *sort = (struct sec_merge_sort *) data;
+
+  qsort (sort->array + sort->bounds[i],
+	 sort->bounds[i + 1] - sort->bounds[i],
+	 sizeof (*sort->array), sort->cmp);
+}
+
+/* Merge the I'th pair of sorted groups of WIDTH runs of the
+   sec_merge_sort DATA into TMP.  */
+
+static void
+merge_runs (void *data, size_t i)
+{
+  struct sec_merge_sort *sort = (struct sec_merge_sort *) data;
+  size_t first = 2 * i * sort->width;
+  size_t lo = sort->bounds[first];
+  size_t mid = sort->bounds[first + sort->width < sort->nruns
+			    ? first + sort->width : sort->nruns];
+  size_t hi = sort->bounds[first + 2 * sort->width < sort->nruns
+			   ? first + 2 * sort->width : sort->nruns];
+  size_t a = lo, b = mid, out = lo;
+
+  while (a < mid && b < hi)
+    if (sort->cmp (&sort->array[a], &sort->array[b]) < 0)
+      sort->tmp[out++] = sort->array[a++];
+    else
+      sort->tmp[out++] = sort->array[b++];
+  while (a < mid)
+    sort->tmp[out++] = sort->array[a++];
+  while (b < hi)
+    sort->tmp[out++] = sort->array[b++];
+}
+
+/* Sort the COUNT entries of ARRAY with CMP.  Big arrays are cut into a
+   run per thread, which are sorted and then merged pairwise in
+   parallel.  CMP never returns zero, so the result is the same as a
+   plain qsort.  */
+
+static void
+sort_strings (struct sec_merge_hash_entry **array, size_t count,
+	      int (*cmp) (const void *, const void *))
+{
+  struct sec_merge_sort sort;
+  size_t i;
+
+  sort.nruns = bfd_get_max_threads ();
+  if (count / 4096 < sort.nruns)
+    sort.nruns = count / 4096;
+  sort.tmp = NULL;
+  sort.bounds = NULL;
+  if (sort.nruns > 1)
+    {
+      sort.tmp = (struct sec_merge_hash_entry **)
+	bfd_malloc (count * sizeof (*array));
+      sort.bounds = (size_t *) bfd_malloc ((sort.nruns + 1)
+					   * sizeof (*sort.bounds));
+    }
+  if (sort.tmp == NULL || sort.bounds == NULL)
+    {
+      free (sort.tmp);
+      free (sort.bounds);
+      qsort (array, count, sizeof (*array), cmp);
+      return;
+    }
+
+  sort.array = array;
+  sort.cmp = cmp;
+  for (i = 0; i <= sort.nruns; i++)
+    sort.bounds[i] = count / sort.nruns * i + (i < count % sort.nruns
+					       ? i : count % sort.nruns);
+  bfd_parallel_for (sort.nruns, sort_run, &sort);
+
+  for (sort.width = 1; sort.width < sort.nruns; sort.width *= 2)
+    {
+      struct sec_merge_hash_entry **t;
+
+      bfd_parallel_for ((sort.nruns + 2 * sort.width - 1) / (2 * sort.width),
+			merge_runs, &sort);
+      t = sort.array;
+      sort.array = sort.tmp;
+      sort.tmp = t;
+    }
+
+  if (sort.array != array)
+    {
+      memcpy (array, sort.array, count * sizeof (*array));
+      sort.tmp = sort.array;
+    }
+  free (sort.tmp);
+  free (sort.bounds);
+}
+
 /* This is a helper function for _bfd_merge_sections.  It attempts to
    merge strings matching suffixes of longer strings.  */
 static struct sec_merge_sec_info *
@@ -660,10 +941,10 @@ merge_strings (struct sec_merge_info *sinfo)
   sinfo->htab->size = a - array;
   if (sinfo->htab->size != 0)
     {
-      qsort (array, (size_t) sinfo->htab->size,
-	     sizeof (struct sec_merge_hash_entry *),
-	     (alignment != (unsigned) -1 && alignment > sinfo->htab->entsize
-	      ? strrevcmp_align : strrevcmp));
+      sort_strings (array, (size_t) sinfo->htab->size,
+		    (alignment != (unsigned) -1
+		     && alignment > sinfo->htab->entsize
+		     ? strrevcmp_align : strrevcmp));
 
       /* Loop over the sorted array and merge suffixes */
       e = *--a;
@@ -739,11 +1020,31 @@ _bfd_merge_sections (bfd *abfd,
 		     void (*remove_hook) (bfd *, asection *))
 {
   struct sec_merge_info *sinfo;
+  struct sec_merge_split *splits;
+  size_t batch;
+  bfd_size_type limit;
+
+  /* With several threads, sections are split into entities and hashed
+     a batch at a time in worker threads, then recorded into the hash
+     table in order.  */
+  splits = NULL;
+  batch = bfd_get_max_threads ();
+  limit = (bfd_size_type) batch * MERGE_BYTES_PER_THREAD;
+  if (batch > 1)
+    {
+      batch *= MERGE_SECTIONS_PER_THREAD;
+      splits = (struct sec_merge_split *) bfd_malloc (batch
+						      * sizeof (*splits));
+      if (splits == NULL)
+	return FALSE;
+    }
 
   for (sinfo = (struct sec_merge_info *) xsinfo; sinfo; sinfo = sinfo->next)
     {
       struct sec_merge_sec_info *secinfo;
       bfd_size_type align;  /* Bytes.  */
+      bfd_size_type bytes;
+      size_t count;
 
       if (! sinfo->chain)
 	continue;
@@ -755,6 +1056,8 @@ _bfd_merge_sections (bfd *abfd,
 
       /* Record the sections into the hash table.  */
       align = 1;
+      count = 0;
+      bytes = 0;
       for (secinfo = sinfo->chain; secinfo; secinfo = secinfo->next)
 	if (secinfo->sec->flags & SEC_EXCLUDE)
 	  {
@@ -764,17 +1067,35 @@ _bfd_merge_sections (bfd *abfd,
 	  }
 	else
 	  {
-	    if (!record_section (sinfo, secinfo))
-	      return FALSE;
+	    asection *sec = secinfo->sec;
+
+	    if (count != 0
+		&& (count == batch || sec->size > limit - bytes))
+	      {
+		if (!record_splits (sinfo, splits, count))
+		  goto error_return;
+		count = 0;
+		bytes = 0;
+	      }
+	    if (splits != NULL && sec->size <= limit)
+	      {
+		memset (&splits[count], 0, sizeof (*splits));
+		splits[count++].secinfo = secinfo;
+		bytes += sec->size;
+	      }
+	    else if (!record_section (sinfo, secinfo))
+	      goto error_return;
 	    if (align)
 	      {
-		unsigned int opb = bfd_octets_per_byte (abfd, secinfo->sec);
+		unsigned int opb = bfd_octets_per_byte (abfd, sec);
 
-		align = (bfd_size_type) 1 << secinfo->sec->alignment_power;
-		if (((secinfo->sec->size / opb) & (align - 1)) != 0)
+		align = (bfd_size_type) 1 << sec->alignment_power;
+		if (((sec->size / opb) & (align - 1)) != 0)
 		  align = 0;
 	      }
 	  }
+      if (count != 0 && !record_splits (sinfo, splits, count))
+	goto error_return;
 
       if (sinfo->htab->first == NULL)
 	continue;
@@ -783,7 +1104,7 @@ _bfd_merge_sections (bfd *abfd,
 	{
 	  secinfo = merge_strings (sinfo);
 	  if (!secinfo)
-	    return FALSE;
+	    goto error_return;
 	}
       else
 	{
@@ -822,7 +1143,12 @@ _bfd_merge_sections (bfd *abfd,
 	  secinfo->sec->flags |= SEC_EXCLUDE | SEC_KEEP;
     }
 
+  free (splits);
   return TRUE;
+
+ error_return:
+  free (splits);
+  return FALSE;
 }
 
 /* Write out the merged section.  */
@@ -928,7 +1254,14 @@ _bfd_merged_section_offset (bfd *output_bfd ATTRIBUTE_UNUSED, asection **psec,
     {
       p = secinfo->contents + (offset / sec->entsize) * sec->entsize;
     }
-  entry = sec_merge_hash_lookup (secinfo->htab, (char *) p, 0, FALSE);
+  {
+    unsigned int len;
+    unsigned long hash = sec_merge_hash_string (secinfo->htab, (char *) p,
+						&len);
+
+    entry = sec_merge_hash_lookup (secinfo->htab, (char *) p, hash, len,
+				   0, FALSE);
+  }
   if (!entry)
     {
       if (! secinfo->htab->strings)
@@ -957,7 +1290,19 @@ _bfd_merge_sections_free (void *xsinfo)
 
   for (sinfo = (struct sec_merge_info *) xsinfo; sinfo; sinfo = sinfo->next)
     {
+      struct sec_merge_sec_info *secinfo;
+
       bfd_hash_table_free (&sinfo->htab->table);
       free (sinfo->htab);
+
+      /* The chain is circular until _bfd_merge_sections runs.  */
+      secinfo = sinfo->chain;
+      while (secinfo != NULL)
+	{
+	  bfd_free_window (&secinfo->view);
+	  secinfo = secinfo->next;
+	  if (secinfo == sinfo->chain)
+	    break;
+	}
     }
 }
@@ -45,6 +45,7 @@
 #include "gdbsupport/filestuff.h"
 #include "build-id.h"
 #include "gdbsupport/pathstuff.h"
+#include <algorithm>
 
 #ifndef O_LARGEFILE
 #define O_LARGEFILE 0
@@ -121,6 +122,17 @@ class core_target final : public process_stratum_target
      targets.  */
   target_section_table m_core_section_table {};
 
+  /* The sections of M_CORE_SECTION_TABLE, sorted by start address.
+     Used by xfer_partial to find the section covering a memory
+     request with a binary search rather than a linear scan of the
+     table, which matters for cores with many thousands of segments.
+     Left empty if the sections overlap, in which case we fall back
+     to the linear lookup.  */
+  std::vector<target_section *> m_core_sections_by_addr;
+
+  /* Build M_CORE_SECTIONS_BY_ADDR.  */
+  void build_core_section_index ();
+
   /* FIXME: kettenis/20031023: Eventually this field should
      disappear.  */
   struct gdbarch *m_core_gdbarch = NULL;
@@ -141,6 +153,8 @@ core_target::core_target ()
 			   &m_core_section_table.sections_end))
     error (_("\"%s\": Can't find sections: %s"),
 	   bfd_get_filename (core_bfd), bfd_errmsg (bfd_get_error ()));
+
+  build_core_section_index ();
 }
 
 core_target::~core_target ()
@@ -148,6 +162,38 @@ core_target::~core_target ()
   xfree (m_core_section_table.sections);
 }
 
+/* See definition.  */
+
+void
+core_target::build_core_section_index ()
+{
+  m_core_sections_by_addr.clear ();
+
+  for (target_section *p = m_core_section_table.sections;
+       p < m_core_section_table.sections_end;
+       p++)
+    if (p->addr < p->endaddr)
+      m_core_sections_by_addr.push_back (p);
+
+  std::sort (m_core_sections_by_addr.begin (), m_core_sections_by_addr.end (),
+	     [] (const target_section *a, const target_section *b)
+	     {
+	       return a->addr < b->addr;
+	     });
+
+  /* The binary search in xfer_partial can only find the right section
+     if there is at most one candidate for each address.  Cores written
+     by sane dumpers never have overlapping segments, but if this one
+     does, keep the original first-match-in-table semantics.  */
+  for (size_t i = 1; i < m_core_sections_by_addr.size (); i++)
+    if (m_core_sections_by_addr[i]->addr
+	< m_core_sections_by_addr[i - 1]->endaddr)
+      {
+	m_core_sections_by_addr.clear ();
+	break;
+      }
+}
+
 static void add_to_thread_list (bfd *, asection *, void *);
 
 /* An arbitrary identifier for the core inferior.  */
@@ -613,6 +659,32 @@ core_target::xfer_partial (enum target_object object, const char *annex,
   switch (object)
     {
     case TARGET_OBJECT_MEMORY:
+      if (!m_core_sections_by_addr.empty ())
+	{
+	  /* Find the last section starting at or before OFFSET.  Like
+	     the linear search below, we only transfer from the section
+	     containing the start of the request; a request straddling
+	     a section end is truncated to that section.  */
+	  auto it = std::upper_bound (m_core_sections_by_addr.begin (),
+				      m_core_sections_by_addr.end (),
+				      offset,
+				      [] (ULONGEST addr,
+					  const target_section *sect)
+				      {
+					return addr < sect->addr;
+				      });
+	  if (it == m_core_sections_by_addr.begin ())
+	    return TARGET_XFER_EOF;
+
+	  target_section *sect = *(it - 1);
+	  if (offset >= sect->endaddr)
+	    return TARGET_XFER_EOF;
+
+	  return section_table_xfer_memory_partial (readbuf, writebuf,
+						    offset, len, xfered_len,
+						    sect, sect + 1, NULL);
+	}
+
       return (section_table_xfer_memory_partial
 	      (readbuf, writebuf,
 	       offset, len, xfered_len,
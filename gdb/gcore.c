@@ -44,6 +44,10 @@
    generate-core-file for programs with large resident data.  */
 #define MAX_COPY_BYTES (1024 * 1024)
 
+/* The granularity at which all-zero memory is left out of the core
+   file as a hole rather than written.  */
+#define GCORE_HOLE_SIZE 4096
+
 static const char *default_gcore_target (void);
 static enum bfd_architecture default_gcore_arch (void);
 static unsigned long default_gcore_mach (void);
@@ -525,11 +529,62 @@ objfile_find_memory_regions (struct target_ops *self,
   return 0;
 }
 
+/* Write SIZE bytes of BUF to OSEC of OBFD at OFFSET, leaving
+   GCORE_HOLE_SIZE-sized blocks that are entirely zero unwritten, so
+   that they end up as holes in the (freshly created, hence sparse)
+   output file.  The block containing the end of the section is always
+   written if END_OF_SECTION, so the file is extended to its full size.
+   Return false, after issuing a warning, if writing failed.  */
+
+static bool
+gcore_write_sparse (bfd *obfd, asection *osec, const gdb_byte *buf,
+		    file_ptr offset, bfd_size_type size, bool end_of_section)
+{
+  static const gdb_byte zeros[GCORE_HOLE_SIZE] = { 0 };
+  bfd_size_type start = 0;
+  bfd_size_type pos = 0;
+
+  while (pos < size)
+    {
+      bfd_size_type block = std::min (size - pos,
+				      (bfd_size_type) GCORE_HOLE_SIZE);
+      bool last = end_of_section && pos + block == size;
+
+      if (!last && memcmp (buf + pos, zeros, block) == 0)
+	{
+	  /* Flush the pending non-zero run, then skip this block.  */
+	  if (pos > start
+	      && !bfd_set_section_contents (obfd, osec, buf + start,
+					    offset + start, pos - start))
+	    {
+	      warning (_("Failed to write corefile contents (%s)."),
+		       bfd_errmsg (bfd_get_error ()));
+	      return false;
+	    }
+	  start = pos + block;
+	}
+      pos += block;
+    }
+
+  if (pos > start
+      && !bfd_set_section_contents (obfd, osec, buf + start,
+				    offset + start, pos - start))
+    {
+      warning (_("Failed to write corefile contents (%s)."),
+	       bfd_errmsg (bfd_get_error ()));
+      return false;
+    }
+
+  return true;
+}
+
 static void
 gcore_copy_callback (bfd *obfd, asection *osec, void *ignored)
 {
   bfd_size_type size, total_size = bfd_section_size (osec);
   file_ptr offset = 0;
+  bfd_size_type failed_size = 0;
+  CORE_ADDR failed_addr = 0;
 
   /* Read-only sections are marked; we don't have to copy their contents.  */
   if ((bfd_section_flags (osec) & SEC_LOAD) == 0)
@@ -547,26 +602,47 @@ gcore_copy_callback (bfd *obfd, asection *osec, void *ignored)
       if (size > total_size)
 	size = total_size;
 
-      if (target_read_memory (bfd_section_vma (osec) + offset,
-			      memhunk.data (), size) != 0)
-	{
-	  warning (_("Memory read failed for corefile "
-		     "section, %s bytes at %s."),
-		   plongest (size),
-		   paddress (target_gdbarch (), bfd_section_vma (osec)));
-	  break;
-	}
-      if (!bfd_set_section_contents (obfd, osec, memhunk.data (),
-				     offset, size))
+      CORE_ADDR addr = bfd_section_vma (osec) + offset;
+      if (target_read_memory (addr, memhunk.data (), size) != 0)
 	{
-	  warning (_("Failed to write corefile contents (%s)."),
-		   bfd_errmsg (bfd_get_error ()));
-	  break;
+	  /* The start of the chunk may still be readable (e.g. a file
+	     mapping that extends past the end of its file).  Retry block
+	     by block up to the first unreadable block, and zero-fill the
+	     rest of the chunk.  Stopping there keeps an unreadable region
+	     from costing one failed request per block, which is very slow
+	     over a remote connection.  */
+	  bfd_size_type pos;
+
+	  for (pos = 0; pos < size; pos += GCORE_HOLE_SIZE)
+	    {
+	      bfd_size_type block = std::min (size - pos,
+					      (bfd_size_type) GCORE_HOLE_SIZE);
+
+	      if (target_read_memory (addr + pos, memhunk.data () + pos,
+				      block) != 0)
+		break;
+	    }
+
+	  pos = std::min (pos, size);
+	  memset (memhunk.data () + pos, 0, size - pos);
+	  if (failed_size == 0)
+	    failed_addr = addr + pos;
+	  failed_size += size - pos;
 	}
 
+      if (!gcore_write_sparse (obfd, osec, memhunk.data (), offset, size,
+			       total_size == size))
+	break;
+
       total_size -= size;
       offset += size;
     }
+
+  if (failed_size != 0)
+    warning (_("Memory read failed for corefile "
+	       "section, %s bytes at %s."),
+	     plongest (failed_size),
+	     paddress (target_gdbarch (), failed_addr));
 }
 
 static int
@@ -39,7 +39,12 @@
 #include "dwarf2/loc.h"
 #include "gdbcore.h"
 #include "floatformat.h"
+#include "observable.h"
+#include "block.h"
+#include "frame.h"
 #include <algorithm>
+#include <tuple>
+#include <unordered_map>
 
 /* Initialize BADNESS constants.  */
 
@@ -2730,6 +2735,175 @@ type::remove_dyn_prop (dynamic_prop_node_kind kind)
     }
 }
 
+/* A cache of the complete types found by check_typedef for opaque and
+   stub types.  When the complete type is in the same objfile as the
+   stub, check_typedef replaces the stub with it, so the search is only
+   done once.  But when it is in another objfile, or there is no
+   complete type at all, the stub stays and every check_typedef of it
+   would search all the objfiles again.  The cache is kept per program
+   space, since that is what the search covers, and is flushed when the
+   set of objfiles changes.  */
+
+struct check_typedef_cache
+{
+  /* The lookup functions match names according to the current
+     language, so it is part of the key.  C++ also looks for opaque
+     types in the namespaces enclosing the selected block, so the
+     result of that search is keyed by that block's scope too; the
+     scope is NULL for all other lookups.  Scope
+     strings live as long as their objfile, and the cache is flushed
+     when an objfile goes away, so comparing them by address is
+     safe.  */
+  typedef std::tuple<struct type *, enum language, const char *> key_type;
+
+  struct key_hash
+  {
+    size_t operator() (const key_type &key) const
+    {
+      return (std::hash<struct type *> () (std::get<0> (key))
+	      + std::hash<int> () (std::get<1> (key))
+	      + std::hash<const char *> () (std::get<2> (key)));
+    }
+  };
+
+  /* Map a stub type to its complete type, or to NULL if there is
+     none.  */
+  std::unordered_map<key_type, struct type *, key_hash> map;
+
+  /* Statistics, for "maint print statistics".  */
+  unsigned long hits = 0;
+  unsigned long misses = 0;
+};
+
+static const program_space_key<check_typedef_cache> check_typedef_cache_key;
+
+/* Return the complete type for the opaque or stub type TYPE, named
+   NAME, or NULL if there is none.  If OPAQUE, TYPE is a struct with no
+   fields, to be resolved with lookup_transparent_type; otherwise it is
+   a stub, whose complete type is looked up as a symbol.  */
+
+static struct type *
+lookup_complete_type (struct type *type, const char *name, bool opaque)
+{
+  check_typedef_cache *cache
+    = check_typedef_cache_key.get (current_program_space);
+  if (cache == NULL)
+    cache = check_typedef_cache_key.emplace (current_program_space);
+
+  enum language lang = current_language->la_language;
+
+  /* C++ looks for an opaque type's definition in the namespaces
+     enclosing the selected block only if there is none at global
+     scope; see cp_lookup_transparent_type.  Finding that scope is not
+     cheap, so the global lookup is cached without it, and the scope is
+     only computed when that lookup failed.  */
+  bool scoped = opaque && lang == language_cplus;
+
+  check_typedef_cache::key_type key (type, lang, NULL);
+  auto iter = cache->map.find (key);
+  bool miss = false;
+  struct type *result;
+  if (iter != cache->map.end ())
+    result = iter->second;
+  else
+    {
+      miss = true;
+      if (scoped)
+	result = basic_lookup_transparent_type (name);
+      else if (opaque)
+	result = lookup_transparent_type (name);
+      else
+	{
+	  /* FIXME: shouldn't we look in STRUCT_DOMAIN and/or VAR_DOMAIN
+	     as appropriate?  */
+	  struct symbol *sym
+	    = lookup_symbol (name, 0, STRUCT_DOMAIN, 0).symbol;
+
+	  result = sym != NULL ? SYMBOL_TYPE (sym) : NULL;
+	}
+      cache->map.emplace (key, result);
+    }
+
+  if (result == NULL && scoped)
+    {
+      const char *scope = block_scope (get_selected_block (0));
+
+      if (scope[0] != '\0')
+	{
+	  key = check_typedef_cache::key_type (type, lang, scope);
+	  iter = cache->map.find (key);
+	  if (iter != cache->map.end ())
+	    result = iter->second;
+	  else
+	    {
+	      miss = true;
+	      result = lookup_transparent_type (name);
+	      cache->map.emplace (key, result);
+	    }
+	}
+    }
+
+  if (miss)
+    ++cache->misses;
+  else
+    ++cache->hits;
+  return result;
+}
+
+/* Flush the check_typedef cache of PSPACE.  */
+
+static void
+check_typedef_cache_flush (struct program_space *pspace)
+{
+  check_typedef_cache *cache = check_typedef_cache_key.get (pspace);
+
+  if (cache != NULL)
+    cache->map.clear ();
+}
+
+/* This module's 'new_objfile' observer.  */
+
+static void
+gdbtypes_new_objfile_observer (struct objfile *objfile)
+{
+  /* OBJFILE may be NULL, so use the current program space.  */
+  check_typedef_cache_flush (current_program_space);
+}
+
+/* This module's 'free_objfile' observer.  */
+
+static void
+gdbtypes_free_objfile_observer (struct objfile *objfile)
+{
+  check_typedef_cache_flush (objfile->pspace);
+}
+
+/* See gdbtypes.h.  */
+
+void
+print_check_typedef_statistics (void)
+{
+  for (struct program_space *pspace : program_spaces)
+    {
+      check_typedef_cache *cache = check_typedef_cache_key.get (pspace);
+
+      printf_filtered (_("Stub type resolution cache for "
+			 "program space %d:\n"),
+		       pspace->num);
+
+      /* If the cache hasn't been created yet, avoid creating one.  */
+      if (cache == NULL)
+	{
+	  printf_filtered (_("  empty, no stats available\n"));
+	  continue;
+	}
+
+      printf_filtered (_("  Entries: %s\n"), pulongest (cache->map.size ()));
+      printf_filtered (_("  Hits: %s\n"), pulongest (cache->hits));
+      printf_filtered (_("  Misses: %s\n"), pulongest (cache->misses));
+    }
+}
+
 /* Find the real type of TYPE.  This function returns the real type,
    after removing all layers of typedefs, and completing opaque or stub
    types.  Completion changes the TYPE argument, but stripping of
@@ -2756,7 +2930,9 @@ type::remove_dyn_prop (dynamic_prop_node_kind kind)
    (but not any code) that if we don't find a full definition, we'd
    set a flag so we don't spend time in the future checking the same
    type.  That would be a mistake, though--we might load in more
-   symbols which contain a full definition for the type.  */
+   symbols which contain a full definition for the type.  Instead,
+   the result of the search is remembered in a per-program-space
+   cache that is flushed whenever an objfile comes or goes.  */
 
 struct type *
 check_typedef (struct type *type)
@@ -2841,7 +3017,7 @@ check_typedef (struct type *type)
 	  stub_noname_complaint ();
 	  return make_qualified_type (type, instance_flags, NULL);
 	}
-      newtype = lookup_transparent_type (name);
+      newtype = lookup_complete_type (type, name, true);
 
       if (newtype)
 	{
@@ -2868,27 +3044,25 @@ check_typedef (struct type *type)
   else if (TYPE_STUB (type) && !currently_reading_symtab)
     {
       const char *name = type->name ();
-      /* FIXME: shouldn't we look in STRUCT_DOMAIN and/or VAR_DOMAIN
-         as appropriate?  */
-      struct symbol *sym;
+      struct type *newtype;
 
       if (name == NULL)
 	{
 	  stub_noname_complaint ();
 	  return make_qualified_type (type, instance_flags, NULL);
 	}
-      sym = lookup_symbol (name, 0, STRUCT_DOMAIN, 0).symbol;
-      if (sym)
+      newtype = lookup_complete_type (type, name, false);
+      if (newtype)
         {
           /* Same as above for opaque types, we can replace the stub
              with the complete type only if they are in the same
              objfile.  */
-	  if (TYPE_OBJFILE (SYMBOL_TYPE (sym)) == TYPE_OBJFILE (type))
-            type = make_qualified_type (SYMBOL_TYPE (sym),
+	  if (TYPE_OBJFILE (newtype) == TYPE_OBJFILE (type))
+            type = make_qualified_type (newtype,
 					TYPE_INSTANCE_FLAGS (type),
 					type);
 	  else
-	    type = SYMBOL_TYPE (sym);
+	    type = newtype;
         }
     }
 
@@ -6010,4 +6184,7 @@ _initialize_gdbtypes ()
 			   NULL, NULL,
 			   show_strict_type_checking,
 			   &setchecklist, &showchecklist);
+
+  gdb::observers::new_objfile.attach (gdbtypes_new_objfile_observer);
+  gdb::observers::free_objfile.attach (gdbtypes_free_objfile_observer);
 }
@@ -2178,6 +2178,11 @@ extern int is_dynamic_type (struct type *type);
 
 extern struct type *check_typedef (struct type *);
 
+/* Print the statistics of check_typedef's cache of stub type
+   resolutions, for "maint print statistics".  */
+
+extern void print_check_typedef_statistics (void);
+
 extern void check_stub_method_group (struct type *, int);
 
 extern char *gdb_mangle_name (struct type *, int, int);
@@ -54,6 +54,7 @@ struct thread_info;
 #include "gdbsupport/forward-scope-exit.h"
 
 #include "gdbsupport/common-inferior.h"
+#include <unordered_map>
 #include "gdbthread.h"
 
 #include "process-stratum-target.h"
@@ -381,6 +382,12 @@ class inferior : public refcounted_object
   /* This inferior's thread list.  */
   thread_info *thread_list = nullptr;
 
+  /* Map from ptid to the first thread in THREAD_LIST with that ptid,
+     so that find_thread_ptid does not need to walk the whole list.
+     Maintained by the thread list management functions in
+     thread.c.  */
+  std::unordered_map<ptid_t, thread_info *, hash_ptid> ptid_thread_map;
+
   /* Returns a range adapter covering the inferior's threads,
      including exited threads.  Used like this:
 
@@ -42,6 +42,8 @@
 #include "readline/tilde.h"
 #include "completer.h"
 #include <forward_list>
+#include <map>
+#include <unordered_map>
 
 static std::string jit_reader_dir;
 
@@ -71,6 +73,19 @@ show_jit_debug (struct ui_file *file, int from_tty,
   fprintf_filtered (file, _("JIT debugging is %s.\n"), value);
 }
 
+/* True if code registered by the inferior should only be read when
+   GDB needs it, rather than as soon as it is registered.  */
+
+static bool jit_lazy_registration = false;
+
+static void
+show_jit_lazy_registration (struct ui_file *file, int from_tty,
+			    struct cmd_list_element *c, const char *value)
+{
+  fprintf_filtered (file, _("Lazy registration of JIT code is %s.\n"),
+		    value);
+}
+
 struct target_buffer
 {
   CORE_ADDR base;
@@ -241,6 +256,18 @@ jit_reader_unload_command (const char *args, int from_tty)
   loaded_jit_reader = NULL;
 }
 
+/* A code entry whose registration was deferred.  */
+
+struct jit_pending_entry
+{
+  /* A copy of the inferior's struct jit_code_entry.  */
+  struct jit_code_entry code_entry;
+
+  /* The architecture the entry was registered with, used when its
+     symbols are finally read.  */
+  struct gdbarch *gdbarch;
+};
+
 /* Per-program space structure recording which objfile has the JIT
    symbols.  */
 
@@ -261,6 +288,18 @@ struct jit_program_space_data
      set.  */
 
   struct breakpoint *jit_breakpoint = nullptr;
+
+  /* Map from the address of a struct jit_code_entry to the objfile
+     created for it.  */
+
+  std::unordered_map<CORE_ADDR, struct objfile *> entry_objfiles;
+
+  /* Code entries that have been registered by the inferior but whose
+     symbols have not been read yet, keyed by the address of the
+     struct jit_code_entry.  This is only used when
+     jit_lazy_registration is set.  */
+
+  std::map<CORE_ADDR, jit_pending_entry> pending_entries;
 };
 
 static program_space_key<jit_program_space_data> jit_program_space_key;
@@ -312,6 +351,12 @@ add_objfile_entry (struct objfile *objfile, CORE_ADDR entry)
 
   objf_data = get_jit_objfile_data (objfile);
   objf_data->addr = entry;
+
+  jit_program_space_data *ps_data
+    = jit_program_space_key.get (objfile->pspace);
+  if (ps_data == NULL)
+    ps_data = jit_program_space_key.emplace (objfile->pspace);
+  ps_data->entry_objfiles[entry] = objfile;
 }
 
 /* Return jit_program_space_data for current program space.  Allocate
@@ -497,7 +542,14 @@ struct gdb_object
 /* The type of the `private' data passed around by the callback
    functions.  */
 
-typedef CORE_ADDR jit_dbg_reader_data;
+struct jit_dbg_reader_data
+{
+  /* Address of the jit_code_entry in the inferior's address space.  */
+  CORE_ADDR entry_addr;
+
+  /* The architecture of the code being read.  */
+  struct gdbarch *gdbarch;
+};
 
 /* The reader calls into this function to read data off the targets
    address space.  */
@@ -747,22 +799,24 @@ jit_object_close_impl (struct gdb_symbol_callbacks *cb,
 
   objfile = objfile::make (nullptr, "<< JIT compiled code >>",
 			   OBJF_NOT_FILENAME);
-  objfile->per_bfd->gdbarch = target_gdbarch ();
+  objfile->per_bfd->gdbarch = priv_data->gdbarch;
 
   for (gdb_symtab &symtab : obj->symtabs)
     finalize_symtab (&symtab, objfile);
 
-  add_objfile_entry (objfile, *priv_data);
+  add_objfile_entry (objfile, priv_data->entry_addr);
 
   delete obj;
 }
 
 /* Try to read CODE_ENTRY using the loaded jit reader (if any).
    ENTRY_ADDR is the address of the struct jit_code_entry in the
-   inferior address space.  */
+   inferior address space.  GDBARCH is the architecture of the
+   code.  */
 
 static int
-jit_reader_try_read_symtab (struct jit_code_entry *code_entry,
+jit_reader_try_read_symtab (struct gdbarch *gdbarch,
+			    struct jit_code_entry *code_entry,
 			    CORE_ADDR entry_addr)
 {
   int status;
@@ -782,7 +836,8 @@ jit_reader_try_read_symtab (struct jit_code_entry *code_entry,
       &priv_data
     };
 
-  priv_data = entry_addr;
+  priv_data.entry_addr = entry_addr;
+  priv_data.gdbarch = gdbarch;
 
   if (!loaded_jit_reader)
     return 0;
@@ -822,7 +877,8 @@ jit_reader_try_read_symtab (struct jit_code_entry *code_entry,
 static void
 jit_bfd_try_read_symtab (struct jit_code_entry *code_entry,
 			 CORE_ADDR entry_addr,
-			 struct gdbarch *gdbarch)
+			 struct gdbarch *gdbarch,
+			 symfile_add_flags add_flags)
 {
   struct bfd_section *sec;
   struct objfile *objfile;
@@ -877,8 +933,8 @@ JITed symbol file is not an object file, ignoring it.\n"));
 
   /* This call does not take ownership of SAI.  */
   objfile = symbol_file_add_from_bfd (nbfd.get (),
-				      bfd_get_filename (nbfd.get ()), 0,
-				      &sai,
+				      bfd_get_filename (nbfd.get ()),
+				      add_flags, &sai,
 				      OBJF_SHARED | OBJF_NOT_FILENAME, NULL);
 
   add_objfile_entry (objfile, entry_addr);
@@ -887,11 +943,13 @@ JITed symbol file is not an object file, ignoring it.\n"));
 /* This function registers code associated with a JIT code entry.  It uses the
    pointer and size pair in the entry to read the symbol file from the remote
    and then calls symbol_file_add_from_local_memory to add it as though it were
-   a symbol file added by the user.  */
+   a symbol file added by the user.  ADD_FLAGS is passed on when a new
+   symbol file is added.  */
 
 static void
 jit_register_code (struct gdbarch *gdbarch,
-		   CORE_ADDR entry_addr, struct jit_code_entry *code_entry)
+		   CORE_ADDR entry_addr, struct jit_code_entry *code_entry,
+		   symfile_add_flags add_flags = 0)
 {
   int success;
 
@@ -902,10 +960,10 @@ jit_register_code (struct gdbarch *gdbarch,
 			paddress (gdbarch, code_entry->symfile_addr),
 			pulongest (code_entry->symfile_size));
 
-  success = jit_reader_try_read_symtab (code_entry, entry_addr);
+  success = jit_reader_try_read_symtab (gdbarch, code_entry, entry_addr);
 
   if (!success)
-    jit_bfd_try_read_symtab (code_entry, entry_addr, gdbarch);
+    jit_bfd_try_read_symtab (code_entry, entry_addr, gdbarch, add_flags);
 }
 
 /* Look up the objfile with this code entry address.  */
@@ -913,16 +971,79 @@ jit_register_code (struct gdbarch *gdbarch,
 static struct objfile *
 jit_find_objf_with_entry_addr (CORE_ADDR entry_addr)
 {
-  for (objfile *objf : current_program_space->objfiles ())
+  jit_program_space_data *ps_data
+    = jit_program_space_key.get (current_program_space);
+  if (ps_data == NULL)
+    return NULL;
+
+  auto iter = ps_data->entry_objfiles.find (entry_addr);
+  if (iter == ps_data->entry_objfiles.end ())
+    return NULL;
+  return iter->second;
+}
+
+/* Register the code described by CODE_ENTRY, located at ENTRY_ADDR.
+   If lazy registration is enabled, this only records the entry; its
+   symbols are read by jit_process_pending_entries.  */
+
+static void
+jit_register_or_defer_code (struct gdbarch *gdbarch,
+			    struct jit_program_space_data *ps_data,
+			    CORE_ADDR entry_addr,
+			    struct jit_code_entry *code_entry)
+{
+  if (jit_lazy_registration)
     {
-      struct jit_objfile_data *objf_data;
+      if (jit_debug)
+	fprintf_unfiltered (gdb_stdlog,
+			    "jit_register_or_defer_code, deferring entry %s\n",
+			    paddress (gdbarch, entry_addr));
+      ps_data->pending_entries[entry_addr] = { *code_entry, gdbarch };
+    }
+  else
+    jit_register_code (gdbarch, entry_addr, code_entry);
+}
 
-      objf_data
-	= (struct jit_objfile_data *) objfile_data (objf, jit_objfile_data);
-      if (objf_data != NULL && objf_data->addr == entry_addr)
-	return objf;
+/* Read the symbols of all the code entries whose registration was
+   deferred by jit_register_or_defer_code, then re-set the breakpoints
+   once for the whole batch.  This must only be called when it is safe
+   to create objfiles, i.e. when the inferior stops or is about to be
+   resumed.  */
+
+static void
+jit_process_pending_entries ()
+{
+  jit_program_space_data *ps_data
+    = jit_program_space_key.get (current_program_space);
+  if (ps_data == NULL || ps_data->pending_entries.empty ())
+    return;
+
+  std::map<CORE_ADDR, jit_pending_entry> entries
+    = std::move (ps_data->pending_entries);
+  ps_data->pending_entries.clear ();
+
+  if (jit_debug)
+    fprintf_unfiltered (gdb_stdlog,
+			"jit_process_pending_entries, %s entries\n",
+			pulongest (entries.size ()));
+
+  /* Re-setting the breakpoints is the expensive part of adding a
+     symbol file, so do it once for the whole batch.  */
+  for (auto &entry : entries)
+    {
+      try
+	{
+	  jit_register_code (entry.second.gdbarch, entry.first,
+			     &entry.second.code_entry,
+			     SYMFILE_DEFER_BP_RESET);
+	}
+      catch (const gdb_exception_error &e)
+	{
+	  exception_print (gdb_stderr, e);
+	}
     }
-  return NULL;
+
+  breakpoint_re_set ();
 }
 
 /* This is called when a breakpoint is deleted.  It updates the
@@ -1279,10 +1400,12 @@ jit_inferior_init (struct gdbarch *gdbarch)
 
       /* This hook may be called many times during setup, so make sure we don't
 	 add the same symbol file twice.  */
-      if (jit_find_objf_with_entry_addr (cur_entry_addr) != NULL)
+      if (jit_find_objf_with_entry_addr (cur_entry_addr) != NULL
+	  || ps_data->pending_entries.count (cur_entry_addr) != 0)
 	continue;
 
-      jit_register_code (gdbarch, cur_entry_addr, &cur_entry);
+      jit_register_or_defer_code (gdbarch, ps_data, cur_entry_addr,
+				  &cur_entry);
     }
 }
 
@@ -1319,6 +1442,11 @@ jit_breakpoint_re_set (void)
 static void
 jit_inferior_exit_hook (struct inferior *inf)
 {
+  jit_program_space_data *ps_data
+    = jit_program_space_key.get (current_program_space);
+  if (ps_data != NULL)
+    ps_data->pending_entries.clear ();
+
   for (objfile *objf : current_program_space->objfiles_safe ())
     {
       struct jit_objfile_data *objf_data
@@ -1336,10 +1464,10 @@ jit_event_handler (struct gdbarch *gdbarch)
   struct jit_code_entry code_entry;
   CORE_ADDR entry_addr;
   struct objfile *objf;
+  struct jit_program_space_data *ps_data = get_jit_program_space_data ();
 
   /* Read the descriptor from remote memory.  */
-  if (!jit_read_descriptor (gdbarch, &descriptor,
-			    get_jit_program_space_data ()))
+  if (!jit_read_descriptor (gdbarch, &descriptor, ps_data))
     return;
   entry_addr = descriptor.relevant_entry;
 
@@ -1350,9 +1478,13 @@ jit_event_handler (struct gdbarch *gdbarch)
       break;
     case JIT_REGISTER:
       jit_read_code_entry (gdbarch, entry_addr, &code_entry);
-      jit_register_code (gdbarch, entry_addr, &code_entry);
+      jit_register_or_defer_code (gdbarch, ps_data, entry_addr, &code_entry);
       break;
     case JIT_UNREGISTER:
+      /* Code that was never read costs nothing to forget.  */
+      if (ps_data->pending_entries.erase (entry_addr) != 0)
+	break;
+
       objf = jit_find_objf_with_entry_addr (entry_addr);
       if (objf == NULL)
 	printf_unfiltered (_("Unable to find JITed code "
@@ -1375,6 +1507,20 @@ free_objfile_data (struct objfile *objfile, void *data)
 {
   struct jit_objfile_data *objf_data = (struct jit_objfile_data *) data;
 
+  if (objf_data->addr != 0)
+    {
+      struct jit_program_space_data *ps_data;
+
+      ps_data = jit_program_space_key.get (objfile->pspace);
+      if (ps_data != NULL)
+	{
+	  auto iter = ps_data->entry_objfiles.find (objf_data->addr);
+	  if (iter != ps_data->entry_objfiles.end ()
+	      && iter->second == objfile)
+	    ps_data->entry_objfiles.erase (iter);
+	}
+    }
+
   if (objf_data->register_code != NULL)
     {
       struct jit_program_space_data *ps_data;
@@ -1392,6 +1538,15 @@ free_objfile_data (struct objfile *objfile, void *data)
   xfree (data);
 }
 
+/* normal_stop observer.  Before the user gets control, make sure all
+   registered code is known and the breakpoints reflect it.  */
+
+static void
+jit_normal_stop (struct bpstats *bs, int print_frame)
+{
+  jit_process_pending_entries ();
+}
+
 /* Initialize the jit_gdbarch_data slot with an instance of struct
    jit_gdbarch_data_type */
 
@@ -1419,10 +1574,23 @@ _initialize_jit ()
 			     NULL,
 			     show_jit_debug,
 			     &setdebuglist, &showdebuglist);
+  add_setshow_boolean_cmd ("jit-lazy-registration", class_support,
+			   &jit_lazy_registration, _("\
+Set whether JIT code is read only when needed."), _("\
+Show whether JIT code is read only when needed."), _("\
+When on, code registered through the JIT interface is not read as soon\n\
+as the inferior registers it.  Instead, pending code is read in a single\n\
+batch when the inferior stops or is about to be resumed.  Breakpoints\n\
+in pending code are not inserted until then.  This is much faster for programs that generate a lot of code."),
+			   NULL,
+			   show_jit_lazy_registration,
+			   &setlist, &showlist);
 
   gdb::observers::inferior_created.attach (jit_inferior_created);
   gdb::observers::inferior_exit.attach (jit_inferior_exit_hook);
   gdb::observers::breakpoint_deleted.attach (jit_breakpoint_deleted);
+  gdb::observers::normal_stop.attach (jit_normal_stop);
+  gdb::observers::about_to_proceed.attach (jit_process_pending_entries);
 
   jit_objfile_data =
     register_objfile_data_with_cleanup (NULL, free_objfile_data);
@@ -456,6 +456,7 @@ maintenance_print_statistics (const char *args, int from_tty)
 {
   print_objfile_statistics ();
   print_symbol_bcache_statistics ();
+  print_check_typedef_statistics ();
 }
 
 static void
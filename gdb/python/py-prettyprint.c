@@ -26,6 +26,12 @@
 #include "python.h"
 #include "python-internal.h"
 #include "cli/cli-style.h"
+#include <deque>
+
+/* The maximum number of children print_children pulls from a
+   printer's children iterator ahead of printing them.  */
+
+#define CHILDREN_READ_AHEAD 1024
 
 /* Return type of print_string_repr.  */
 
@@ -346,6 +352,53 @@ print_string_repr (PyObject *printer, const char *hint,
   return result;
 }
 
+/* Pull up to COUNT items from the children iterator ITER, append them
+   to QUEUE, and fetch the lazy values among them all at once, so that
+   adjacent children (e.g. the elements of a vector) are read from the
+   inferior with a single memory access instead of one each.  Set
+   *DONE if the iterator is exhausted; if it raised an exception, stash
+   it in ERROR, to be reported once the items before it are printed.  */
+
+static void
+read_ahead_children (PyObject *iter, unsigned int count,
+		     std::deque<gdbpy_ref<>> &queue, bool *done,
+		     gdb::optional<gdbpy_err_fetch> &error)
+{
+  std::vector<value *> values;
+
+  for (unsigned int n = 0; n < count; ++n)
+    {
+      gdbpy_ref<> item (PyIter_Next (iter));
+      if (item == NULL)
+	{
+	  *done = true;
+	  if (PyErr_Occurred ())
+	    error.emplace ();
+	  break;
+	}
+
+      /* Malformed items are diagnosed when printed.  */
+      if (PyTuple_Check (item.get ()) && PyTuple_Size (item.get ()) == 2)
+	{
+	  PyObject *py_v = PyTuple_GET_ITEM (item.get (), 1);
+
+	  if (PyObject_TypeCheck (py_v, &value_object_type))
+	    values.push_back (value_object_to_value (py_v));
+	}
+
+      queue.push_back (std::move (item));
+    }
+
+  try
+    {
+      value_fetch_lazy_batch (values);
+    }
+  catch (const gdb_exception_error &except)
+    {
+      /* Any error will be reported when printing the value.  */
+    }
+}
+
 /* Helper for gdbpy_apply_val_pretty_printer that formats children of the
    printer, if any exist.  If is_py_none is true, then nothing has
    been printed by to_string, and format output accordingly. */
@@ -394,17 +447,37 @@ print_children (PyObject *printer, const char *hint,
 	pretty = options->prettyformat_structs;
     }
 
+  std::deque<gdbpy_ref<>> read_ahead;
+  bool iter_done = false;
+  gdb::optional<gdbpy_err_fetch> iter_error;
+
   done_flag = 0;
   for (i = 0; i < options->print_max; ++i)
     {
       PyObject *py_v;
       const char *name;
 
-      gdbpy_ref<> item (PyIter_Next (iter.get ()));
+      /* In summary mode, only the first child is looked at.  */
+      if (read_ahead.empty () && !iter_done)
+	read_ahead_children (iter.get (),
+			     (options->summary ? 1
+			      : std::min (options->print_max - i,
+					  (unsigned int) CHILDREN_READ_AHEAD)),
+			     read_ahead, &iter_done, iter_error);
+
+      gdbpy_ref<> item;
+      if (!read_ahead.empty ())
+	{
+	  item = std::move (read_ahead.front ());
+	  read_ahead.pop_front ();
+	}
       if (item == NULL)
 	{
-	  if (PyErr_Occurred ())
-	    print_stack_unless_memory_error (stream);
+	  if (iter_error.has_value ())
+	    {
+	      iter_error->restore ();
+	      print_stack_unless_memory_error (stream);
+	    }
 	  /* Set a flag so we can know whether we printed all the
 	     available elements.  */
 	  else	
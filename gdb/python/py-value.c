@@ -1210,6 +1210,329 @@ valpy_fetch_lazy (PyObject *self, PyObject *args)
   Py_RETURN_NONE;
 }
 
+/* Implements gdb.fetch_lazy_values (VALUES).  */
+
+PyObject *
+gdbpy_fetch_lazy_values (PyObject *self, PyObject *args)
+{
+  PyObject *seq;
+
+  if (!PyArg_ParseTuple (args, "O", &seq))
+    return NULL;
+
+  gdbpy_ref<> iter (PyObject_GetIter (seq));
+  if (iter == NULL)
+    return NULL;
+
+  /* Keep the items alive, in case SEQ is a generator.  */
+  std::vector<gdbpy_ref<>> items;
+  std::vector<value *> values;
+  while (true)
+    {
+      gdbpy_ref<> item (PyIter_Next (iter.get ()));
+      if (item == NULL)
+	{
+	  if (PyErr_Occurred ())
+	    return NULL;
+	  break;
+	}
+
+      if (!PyObject_TypeCheck (item.get (), &value_object_type))
+	{
+	  PyErr_SetString (PyExc_TypeError,
+			   _("Argument must be a sequence of gdb.Value "
+			     "objects."));
+	  return NULL;
+	}
+
+      values.push_back (((value_object *) item.get ())->value);
+      items.push_back (std::move (item));
+    }
+
+  try
+    {
+      value_fetch_lazy_batch (values);
+
+      /* Fetch whatever could not be fetched in bulk, so that errors
+	 are reported.  */
+      for (value *val : values)
+	if (value_lazy (val))
+	  value_fetch_lazy (val);
+    }
+  catch (const gdb_exception &except)
+    {
+      GDB_PY_HANDLE_EXCEPTION (except);
+    }
+
+  Py_RETURN_NONE;
+}
+
+#ifdef IS_PY3K
+
+/* An object exporting the contents of a gdb.Value through the buffer
+   protocol, for Value.contents_view.  The contents are not copied:
+   the buffer points into the value's own contents, which the
+   reference to the gdb.Value keeps alive.  */
+
+struct valview_object
+{
+  PyObject_HEAD
+
+  /* The gdb.Value whose contents are viewed.  */
+  PyObject *value;
+
+  /* The first byte of the first item.  */
+  const gdb_byte *start;
+
+  /* The layout of the view, as described by the buffer protocol.  */
+  int ndim;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+  Py_ssize_t itemsize;
+  char format[3];
+};
+
+extern PyTypeObject valview_object_type
+    CPYCHECKER_TYPE_OBJECT_FOR_TYPEDEF ("valview_object");
+
+/* Deallocator for valview_object.  */
+
+static void
+valview_dealloc (PyObject *self)
+{
+  Py_XDECREF (((valview_object *) self)->value);
+  Py_TYPE (self)->tp_free (self);
+}
+
+/* Implement the buffer protocol's getbuffer for valview_object.  */
+
+static int
+valview_getbuffer (PyObject *self, Py_buffer *buf, int flags)
+{
+  valview_object *view = (valview_object *) self;
+
+  buf->obj = NULL;
+
+  if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE)
+    {
+      PyErr_SetString (PyExc_BufferError,
+		       _("The contents of a value are read-only."));
+      return -1;
+    }
+
+  Py_ssize_t len = view->itemsize;
+  bool contiguous = true;
+  for (int i = view->ndim - 1; i >= 0; --i)
+    {
+      if (view->shape[i] > 1 && view->strides[i] != len)
+	contiguous = false;
+      len *= view->shape[i];
+    }
+
+  if (!contiguous && (flags & PyBUF_STRIDES) != PyBUF_STRIDES)
+    {
+      PyErr_SetString (PyExc_BufferError,
+		       _("This view of the value is not contiguous."));
+      return -1;
+    }
+
+  buf->buf = (void *) view->start;
+  buf->obj = self;
+  Py_INCREF (self);
+  buf->len = len;
+  buf->readonly = 1;
+  buf->itemsize = view->itemsize;
+  /* Despite the documentation saying this field is a "const char *",
+     in Python 3.4 at least, it's really a "char *".  */
+  buf->format = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT
+		 ? view->format : NULL);
+  buf->ndim = view->ndim;
+  buf->shape = (flags & PyBUF_ND) == PyBUF_ND ? view->shape : NULL;
+  buf->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES
+		  ? view->strides : NULL);
+  buf->suboffsets = NULL;
+  buf->internal = NULL;
+
+  return 0;
+}
+
+/* If the scalar type TYPE can be described by a format character of
+   Python's struct module, store it in FORMAT, preceded by a byte order
+   mark if the target's byte order is not the host's, and return true.
+   Otherwise, return false.  */
+
+static bool
+valview_scalar_format (struct type *type, char *format)
+{
+  char code = 0;
+
+  switch (type->code ())
+    {
+    case TYPE_CODE_BOOL:
+      if (TYPE_LENGTH (type) == 1)
+	{
+	  code = '?';
+	  break;
+	}
+      /* Fall through.  */
+    case TYPE_CODE_INT:
+    case TYPE_CODE_CHAR:
+    case TYPE_CODE_ENUM:
+    case TYPE_CODE_PTR:
+      {
+	bool is_unsigned = (TYPE_UNSIGNED (type)
+			    || type->code () != TYPE_CODE_INT);
+
+	switch (TYPE_LENGTH (type))
+	  {
+	  case 1:
+	    code = is_unsigned ? 'B' : 'b';
+	    break;
+	  case 2:
+	    code = is_unsigned ? 'H' : 'h';
+	    break;
+	  case 4:
+	    code = is_unsigned ? 'I' : 'i';
+	    break;
+	  case 8:
+	    code = is_unsigned ? 'Q' : 'q';
+	    break;
+	  }
+      }
+      break;
+
+    case TYPE_CODE_FLT:
+      {
+	const struct floatformat *fmt = floatformat_from_type (type);
+	enum bfd_endian order = type_byte_order (type);
+
+	if (TYPE_LENGTH (type) == 4 && fmt == floatformats_ieee_single[order])
+	  code = 'f';
+	else if (TYPE_LENGTH (type) == 8
+		 && fmt == floatformats_ieee_double[order])
+	  code = 'd';
+      }
+      break;
+    }
+
+  if (code == 0)
+    return false;
+
+#if WORDS_BIGENDIAN
+  const enum bfd_endian host_order = BFD_ENDIAN_BIG;
+#else
+  const enum bfd_endian host_order = BFD_ENDIAN_LITTLE;
+#endif
+  if (TYPE_LENGTH (type) > 1 && type_byte_order (type) != host_order)
+    *format++ = type_byte_order (type) == BFD_ENDIAN_BIG ? '>' : '<';
+  *format++ = code;
+  *format = '\0';
+
+  return true;
+}
+
+/* Implements gdb.Value.contents_view ([field]).  Return a memoryview
+   of the contents of the value.  */
+
+static PyObject *
+valpy_contents_view (PyObject *self, PyObject *args, PyObject *kw)
+{
+  static const char *keywords[] = { "field", NULL };
+  const char *field = NULL;
+
+  if (!gdb_PyArg_ParseTupleAndKeywords (args, kw, "|s", keywords, &field))
+    return NULL;
+
+  gdbpy_ref<valview_object> view (PyObject_New (valview_object,
+						&valview_object_type));
+  if (view == NULL)
+    return NULL;
+  view->value = NULL;
+
+  try
+    {
+      struct value *val = ((value_object *) self)->value;
+      struct type *type = check_typedef (value_type (val));
+      struct type *item_type = type;
+      LONGEST count = -1;
+      LONGEST stride = 0;
+
+      if (type->code () == TYPE_CODE_ARRAY)
+	{
+	  LONGEST low, high;
+
+	  if (TYPE_FIELD_BITSIZE (type, 0) != 0)
+	    error (_("Arrays with a stride are not supported."));
+	  if (get_array_bounds (type, &low, &high) < 0)
+	    error (_("Could not determine the array bounds."));
+
+	  item_type = check_typedef (TYPE_TARGET_TYPE (type));
+	  count = high >= low ? high - low + 1 : 0;
+	  stride = TYPE_LENGTH (item_type);
+	}
+
+      /* This fetches the value if needed, and errors out if any of it
+	 is unavailable or optimized out.  */
+      view->start = value_contents (val);
+
+      if (field != NULL)
+	{
+	  if (item_type->code () != TYPE_CODE_STRUCT
+	      && item_type->code () != TYPE_CODE_UNION)
+	    error (_("Not a structure or union, or an array of them."));
+
+	  struct_elt elt = lookup_struct_elt (item_type, field, 1);
+	  if (elt.field == NULL)
+	    error (_("There is no member named %s."), field);
+	  if (FIELD_BITSIZE (*elt.field) != 0 || elt.offset % 8 != 0)
+	    error (_("Bitfield %s can't be viewed."), field);
+
+	  item_type = check_typedef (elt.field->type ());
+	  view->start += elt.offset / 8;
+	}
+
+      if (valview_scalar_format (item_type, view->format))
+	{
+	  /* A scalar, or a vector of them.  */
+	  view->itemsize = TYPE_LENGTH (item_type);
+	  view->ndim = count < 0 ? 0 : 1;
+	  view->shape[0] = count;
+	  view->strides[0] = stride;
+	}
+      else
+	{
+	  /* The bytes of a compound item, or a vector of rows of them.  */
+	  strcpy (view->format, "B");
+	  view->itemsize = 1;
+	  if (count < 0)
+	    {
+	      view->ndim = 1;
+	      view->shape[0] = TYPE_LENGTH (item_type);
+	      view->strides[0] = 1;
+	    }
+	  else
+	    {
+	      view->ndim = 2;
+	      view->shape[0] = count;
+	      view->strides[0] = stride;
+	      view->shape[1] = TYPE_LENGTH (item_type);
+	      view->strides[1] = 1;
+	    }
+	}
+    }
+  catch (const gdb_exception &except)
+    {
+      GDB_PY_HANDLE_EXCEPTION (except);
+    }
+
+  view->value = self;
+  Py_INCREF (self);
+
+  return PyMemoryView_FromObject ((PyObject *) view.get ());
+}
+
+#endif /* IS_PY3K */
+
 /* Calculate and return the address of the PyObject as the value of
    the builtin __hash__ call.  */
 static Py_hash_t
@@ -2044,6 +2367,11 @@ gdbpy_initialize_values (void)
   if (PyType_Ready (&value_object_type) < 0)
     return -1;
 
+#ifdef IS_PY3K
+  if (PyType_Ready (&valview_object_type) < 0)
+    return -1;
+#endif
+
   return gdb_pymodule_addobject (gdb_module, "Value",
 				 (PyObject *) &value_object_type);
 }
@@ -2096,6 +2424,14 @@ Return a lazy string representation of the value." },
 Return Unicode string representation of the value." },
   { "fetch_lazy", valpy_fetch_lazy, METH_NOARGS,
     "Fetches the value from the inferior, if it was lazy." },
+#ifdef IS_PY3K
+  { "contents_view", (PyCFunction) valpy_contents_view,
+    METH_VARARGS | METH_KEYWORDS,
+    "contents_view ([field]) -> memoryview\n\
+Return a read-only memoryview of the contents of the value, without\n\
+copying them.  If FIELD is given, view that field of the structure,\n\
+or of each structure in the array." },
+#endif
   { "format_string", (PyCFunction) valpy_format_string,
     METH_VARARGS | METH_KEYWORDS,
     "format_string (...) -> string\n\
@@ -2204,3 +2540,36 @@ PyTypeObject value_object_type = {
   0,				  /* tp_alloc */
   valpy_new			  /* tp_new */
 };
+
+#ifdef IS_PY3K
+
+static PyBufferProcs valview_buffer_procs =
+{
+  valview_getbuffer
+};
+
+PyTypeObject valview_object_type = {
+  PyVarObject_HEAD_INIT (NULL, 0)
+  "gdb.ValueView",		  /*tp_name*/
+  sizeof (valview_object),	  /*tp_basicsize*/
+  0,				  /*tp_itemsize*/
+  valview_dealloc,		  /*tp_dealloc*/
+  0,				  /*tp_print*/
+  0,				  /*tp_getattr*/
+  0,				  /*tp_setattr*/
+  0,				  /*tp_compare*/
+  0,				  /*tp_repr*/
+  0,				  /*tp_as_number*/
+  0,				  /*tp_as_sequence*/
+  0,				  /*tp_as_mapping*/
+  0,				  /*tp_hash */
+  0,				  /*tp_call*/
+  0,				  /*tp_str*/
+  0,				  /*tp_getattro*/
+  0,				  /*tp_setattro*/
+  &valview_buffer_procs,	  /*tp_as_buffer*/
+  Py_TPFLAGS_DEFAULT,		  /*tp_flags*/
+  "GDB value contents view object", /*tp_doc*/
+};
+
+#endif /* IS_PY3K */
@@ -1985,6 +1985,10 @@ PyMethodDef python_GdbMethods[] =
 {
   { "history", gdbpy_history, METH_VARARGS,
     "Get a value from history" },
+  { "fetch_lazy_values", gdbpy_fetch_lazy_values, METH_VARARGS,
+    "fetch_lazy_values (values) -> None.\n\
+Fetch the contents of the lazy gdb.Value objects in the sequence VALUES\n\
+from the inferior, reading adjacent values together." },
   { "execute", (PyCFunction) execute_gdb_command, METH_VARARGS | METH_KEYWORDS,
     "execute (command [, from_tty] [, to_string]) -> [String]\n\
 Evaluate command, a string, as a gdb CLI command.  Optionally returns\n\
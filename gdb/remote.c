@@ -77,6 +77,7 @@
 #include "gdbsupport/byte-vector.h"
 #include <algorithm>
 #include <unordered_map>
+#include <unordered_set>
 #include "async-event.h"
 
 /* The remote target.  */
@@ -305,6 +306,11 @@ class remote_state
   ptid_t general_thread = null_ptid;
   ptid_t continue_thread = null_ptid;
 
+  /* The first thread whose 'g' registers were fetched since the target
+     was last resumed, or null_ptid.  Registers of other threads are
+     only fetched in batches once GDB moves on to a second thread.  */
+  ptid_t first_g_fetch_thread = null_ptid;
+
   /* This is the traceframe which we last selected on the remote system.
      It will be -1 if no traceframe is selected.  */
   int remote_traceframe_number = -1;
@@ -841,8 +847,9 @@ class remote_target : public process_stratum_target
   int fetch_register_using_p (struct regcache *regcache,
 			      packet_reg *reg);
   int send_g_packet ();
-  void process_g_packet (struct regcache *regcache);
+  void process_g_packet (struct regcache *regcache, const char *buf);
   void fetch_registers_using_g (struct regcache *regcache);
+  bool fetch_registers_using_batch (struct regcache *regcache);
   int store_register_using_P (const struct regcache *regcache,
 			      packet_reg *reg);
   void store_registers_using_G (const struct regcache *regcache);
@@ -2093,6 +2100,12 @@ enum {
   /* Support TARGET_WAITKIND_NO_RESUMED.  */
   PACKET_no_resumed,
 
+  /* Support for the qThreadRegisters packet.  */
+  PACKET_qThreadRegisters,
+
+  /* Support for the 'x' binary memory read packet.  */
+  PACKET_x,
+
   PACKET_MAX
 };
 
@@ -3827,13 +3840,18 @@ remote_target::update_thread_list ()
 
       /* CONTEXT now holds the current thread list on the remote
 	 target end.  Delete GDB-side threads no longer found on the
-	 target.  */
+	 target.  Index the remote list first so that this is not
+	 quadratic in the number of threads.  */
+      std::unordered_set<ptid_t, hash_ptid> remote_ptids;
+      for (const thread_item &item : context.items)
+	remote_ptids.insert (item.ptid);
+
       for (thread_info *tp : all_threads_safe ())
 	{
 	  if (tp->inf->process_target () != this)
 	    continue;
 
-	  if (!context.contains_thread (tp->ptid))
+	  if (remote_ptids.find (tp->ptid) == remote_ptids.end ())
 	    {
 	      /* Do not remove the thread if it is the last thread in
 		 the inferior.  This situation happens when we have a
@@ -5233,6 +5251,9 @@ static const struct protocol_feature remote_protocol_features[] = {
   { "vContSupported", PACKET_DISABLE, remote_supported_packet, PACKET_vContSupported },
   { "QThreadEvents", PACKET_DISABLE, remote_supported_packet, PACKET_QThreadEvents },
   { "no-resumed", PACKET_DISABLE, remote_supported_packet, PACKET_no_resumed },
+  { "qThreadRegisters", PACKET_DISABLE, remote_supported_packet,
+    PACKET_qThreadRegisters },
+  { "binary-upload", PACKET_DISABLE, remote_supported_packet, PACKET_x },
 };
 
 static char *remote_support_xml;
@@ -6299,6 +6320,8 @@ remote_target::resume (ptid_t ptid, int step, enum gdb_signal siggnal)
 {
   struct remote_state *rs = get_remote_state ();
 
+  rs->first_g_fetch_thread = null_ptid;
+
   /* When connected in non-stop mode, the core resumes threads
      individually.  Resuming remote threads directly in target_resume
      would thus result in sending one packet per thread.  Instead, to
@@ -8113,24 +8136,26 @@ remote_target::send_g_packet ()
   return buf_len / 2;
 }
 
+/* Supply the registers in BUF, encoded as in a 'g' packet reply, to
+   REGCACHE.  */
+
 void
-remote_target::process_g_packet (struct regcache *regcache)
+remote_target::process_g_packet (struct regcache *regcache, const char *buf)
 {
   struct gdbarch *gdbarch = regcache->arch ();
   struct remote_state *rs = get_remote_state ();
   remote_arch_state *rsa = rs->get_remote_arch_state (gdbarch);
   int i, buf_len;
-  char *p;
+  const char *p;
   char *regs;
 
-  buf_len = strlen (rs->buf.data ());
+  buf_len = strlen (buf);
 
   /* Further sanity checks, with knowledge of the architecture.  */
   if (buf_len > 2 * rsa->sizeof_g_packet)
     error (_("Remote 'g' packet reply is too long (expected %ld bytes, got %d "
 	     "bytes): %s"),
-	   rsa->sizeof_g_packet, buf_len / 2,
-	   rs->buf.data ());
+	   rsa->sizeof_g_packet, buf_len / 2, buf);
 
   /* Save the size of the packet sent to us by the target.  It is used
      as a heuristic when determining the max size of packets that the
@@ -8180,7 +8205,7 @@ remote_target::process_g_packet (struct regcache *regcache)
      hex characters.  Suck them all up, then supply them to the
      register cacheing/storage mechanism.  */
 
-  p = rs->buf.data ();
+  p = buf;
   for (i = 0; i < rsa->sizeof_g_packet; i++)
     {
       if (p[0] == 0 || p[1] == 0)
@@ -8202,13 +8227,13 @@ remote_target::process_g_packet (struct regcache *regcache)
 
       if (r->in_g_packet)
 	{
-	  if ((r->offset + reg_size) * 2 > strlen (rs->buf.data ()))
+	  if ((r->offset + reg_size) * 2 > buf_len)
 	    /* This shouldn't happen - we adjusted in_g_packet above.  */
 	    internal_error (__FILE__, __LINE__,
 			    _("unexpected end of 'g' packet reply"));
-	  else if (rs->buf[r->offset * 2] == 'x')
+	  else if (buf[r->offset * 2] == 'x')
 	    {
-	      gdb_assert (r->offset * 2 < strlen (rs->buf.data ()));
+	      gdb_assert (r->offset * 2 < buf_len);
 	      /* The register isn't available, mark it as such (at
 		 the same time setting the value to zero).  */
 	      regcache->raw_supply (r->regnum, NULL);
@@ -8219,11 +8244,173 @@ remote_target::process_g_packet (struct regcache *regcache)
     }
 }
 
+/* Try to fetch the 'g' packet registers of REGCACHE's thread with a
+   qThreadRegisters packet, which also fetches the registers of other
+   stopped threads of the same inferior whose registers we have not
+   read yet.  Commands that walk all threads, like "thread apply all
+   bt", then need one round trip per batch of threads instead of an
+   Hg/g pair per thread.  Returns true if REGCACHE was filled in.
+
+   Most stops, e.g. each step of a "next" in all-stop mode, only read
+   the registers of the thread that reported the event, so batching
+   starts only when GDB reads the registers of a second thread after
+   the target last resumed.  */
+
+bool
+remote_target::fetch_registers_using_batch (struct regcache *regcache)
+{
+  struct gdbarch *gdbarch = regcache->arch ();
+  struct remote_state *rs = get_remote_state ();
+  remote_arch_state *rsa = rs->get_remote_arch_state (gdbarch);
+
+  if (packet_support (PACKET_qThreadRegisters) == PACKET_DISABLE)
+    return false;
+
+  if (rs->first_g_fetch_thread == null_ptid)
+    rs->first_g_fetch_thread = regcache->ptid ();
+  if (rs->first_g_fetch_thread == regcache->ptid ())
+    return false;
+
+  /* Only the 'g' packet reads registers from the selected
+     traceframe.  */
+  if (get_traceframe_number () != -1)
+    return false;
+
+  /* A register that is known to be in the 'g' packet, used to tell
+     whether another thread's registers have been fetched already.  */
+  int probe_regnum = -1;
+  for (int i = 0; i < gdbarch_num_regs (gdbarch); i++)
+    if (rsa->regs[i].in_g_packet)
+      {
+	probe_regnum = i;
+	break;
+      }
+  if (probe_regnum == -1)
+    return false;
+
+  /* Guess how many threads' registers fit in a reply, allowing for
+     the header of each entry.  The registers are sent in binary, and
+     escaping rarely grows them much.  */
+  long entry_size = rsa->sizeof_g_packet + 50;
+  size_t max_threads = std::max (1L, get_remote_packet_size () / entry_size);
+
+  std::vector<ptid_t> ptids;
+  ptids.push_back (regcache->ptid ());
+
+  inferior *inf = find_inferior_ptid (this, regcache->ptid ());
+  if (inf != nullptr)
+    for (thread_info *tp : inf->non_exited_threads ())
+      {
+	if (ptids.size () >= max_threads)
+	  break;
+
+	if (tp->ptid == regcache->ptid () || tp->executing
+	    || target_thread_architecture (tp->ptid) != gdbarch)
+	  continue;
+
+	struct regcache *other
+	  = get_thread_arch_regcache (this, tp->ptid, gdbarch);
+	if (other->get_register_status (probe_regnum) == REG_UNKNOWN)
+	  ptids.push_back (tp->ptid);
+      }
+
+  char *p = rs->buf.data ();
+  char *endp = p + get_remote_packet_size ();
+
+  p += xsnprintf (p, endp - p, "qThreadRegisters:");
+  for (size_t i = 0; i < ptids.size (); i++)
+    {
+      /* Leave room for a full thread id and separator.  */
+      if (endp - p < 40)
+	{
+	  ptids.resize (i);
+	  break;
+	}
+      if (i > 0)
+	*p++ = ';';
+      p = write_ptid (p, endp, ptids[i]);
+    }
+
+  putpkt (rs->buf);
+  int packet_len = getpkt_sane (&rs->buf, 0);
+  if (packet_len < 0)
+    return false;
+
+  if (packet_ok (rs->buf, &remote_protocol_packets[PACKET_qThreadRegisters])
+      != PACKET_OK)
+    return false;
+
+  bool multi_process = remote_multi_process_p (rs);
+  bool found = false;
+
+  /* Each entry is "PTID:SIZE:REGS", REGS being SIZE bytes of escaped
+     binary data.  */
+  const char *q = rs->buf.data ();
+  const char *end = q + packet_len;
+  while (q < end)
+    {
+      ptid_t ptid = read_ptid (q, &q);
+      ULONGEST size;
+
+      if (*q != ':')
+	error (_("Malformed qThreadRegisters reply"));
+      q = unpack_varlen_hex (q + 1, &size);
+      if (*q != ':' || size > rsa->sizeof_g_packet)
+	error (_("Malformed qThreadRegisters reply"));
+      q++;
+
+      gdb::byte_vector bin (size);
+      for (ULONGEST i = 0; i < size; i++)
+	{
+	  if (q >= end)
+	    error (_("Truncated qThreadRegisters reply"));
+	  gdb_byte c = *q++;
+	  if (c == '}')
+	    {
+	      if (q >= end)
+		error (_("Truncated qThreadRegisters reply"));
+	      c = *q++ ^ 0x20;
+	    }
+	  bin[i] = c;
+	}
+
+      /* process_g_packet parses the 'g' reply's hex encoding.  */
+      std::string regs = bin2hex (bin.data (), size);
+
+      /* Without the multi-process extensions, read_ptid guesses the
+	 pid, so match on the thread id only.  */
+      auto it = std::find_if (ptids.begin (), ptids.end (),
+			      [&] (ptid_t requested)
+			      {
+				return (multi_process
+					? requested == ptid
+					: requested.lwp () == ptid.lwp ());
+			      });
+      if (it != ptids.end ())
+	{
+	  if (*it == regcache->ptid ())
+	    {
+	      process_g_packet (regcache, regs.c_str ());
+	      found = true;
+	    }
+	  else
+	    process_g_packet (get_thread_arch_regcache (this, *it, gdbarch),
+			      regs.c_str ());
+	}
+    }
+
+  return found;
+}
+
 void
 remote_target::fetch_registers_using_g (struct regcache *regcache)
 {
+  if (fetch_registers_using_batch (regcache))
+    return;
+
+  set_general_thread (regcache->ptid ());
   send_g_packet ();
-  process_g_packet (regcache);
+  process_g_packet (regcache, get_remote_state ()->buf.data ());
 }
 
 /* Make the remote selected traceframe match GDB's selected
@@ -8258,7 +8445,6 @@ remote_target::fetch_registers (struct regcache *regcache, int regnum)
   int i;
 
   set_remote_traceframe ();
-  set_general_thread (regcache->ptid ());
 
   if (regnum >= 0)
     {
@@ -8277,6 +8463,7 @@ remote_target::fetch_registers (struct regcache *regcache, int regnum)
 	    return;
 	}
 
+      set_general_thread (regcache->ptid ());
       if (fetch_register_using_p (regcache, reg))
 	return;
 
@@ -8290,11 +8477,14 @@ remote_target::fetch_registers (struct regcache *regcache, int regnum)
 
   for (i = 0; i < gdbarch_num_regs (gdbarch); i++)
     if (!rsa->regs[i].in_g_packet)
-      if (!fetch_register_using_p (regcache, &rsa->regs[i]))
-	{
-	  /* This register is not available.  */
-	  regcache->raw_supply (i, NULL);
-	}
+      {
+	set_general_thread (regcache->ptid ());
+	if (!fetch_register_using_p (regcache, &rsa->regs[i]))
+	  {
+	    /* This register is not available.  */
+	    regcache->raw_supply (i, NULL);
+	  }
+      }
 }
 
 /* Prepare to store registers.  Since we may send them all (using a
@@ -8838,33 +9028,53 @@ remote_target::remote_read_bytes_1 (CORE_ADDR memaddr, gdb_byte *myaddr,
   char *p;
   int todo_units;
   int decoded_bytes;
+  int packet_len;
+  bool binary = packet_support (PACKET_x) == PACKET_ENABLE;
 
   buf_size_bytes = get_memory_read_packet_size ();
   /* The packet buffer will be large enough for the payload;
      get_memory_packet_size ensures this.  */
 
-  /* Number of units that will fit.  */
+  /* Number of units that will fit.  The 'm' reply takes two hex
+     characters per byte.  The 'x' reply takes one character for most
+     bytes, and the stub sends fewer units if escaping makes the data
+     not fit.  */
   todo_units = std::min (len_units,
-			 (ULONGEST) (buf_size_bytes / unit_size) / 2);
+			 (ULONGEST) (buf_size_bytes / unit_size)
+			 / (binary ? 1 : 2));
 
-  /* Construct "m"<memaddr>","<len>".  */
+  /* Construct "m"<memaddr>","<len>" or "x"<memaddr>","<len>".  */
   memaddr = remote_address_masked (memaddr);
   p = rs->buf.data ();
-  *p++ = 'm';
+  *p++ = binary ? 'x' : 'm';
   p += hexnumstr (p, (ULONGEST) memaddr);
   *p++ = ',';
   p += hexnumstr (p, (ULONGEST) todo_units);
   *p = '\0';
   putpkt (rs->buf);
-  getpkt (&rs->buf, 0);
+  packet_len = getpkt_sane (&rs->buf, 0);
+  if (packet_len < 0)
+    return TARGET_XFER_E_IO;
   if (rs->buf[0] == 'E'
       && isxdigit (rs->buf[1]) && isxdigit (rs->buf[2])
       && rs->buf[3] == '\0')
     return TARGET_XFER_E_IO;
-  /* Reply describes memory byte by byte, each byte encoded as two hex
-     characters.  */
-  p = rs->buf.data ();
-  decoded_bytes = hex2bin (p, myaddr, todo_units * unit_size);
+  if (binary)
+    {
+      /* Reply is 'b' followed by the escaped binary contents.  */
+      if (rs->buf[0] != 'b')
+	error (_("Unexpected reply to 'x' packet: %s"), rs->buf.data ());
+      decoded_bytes = remote_unescape_input ((gdb_byte *) rs->buf.data () + 1,
+					     packet_len - 1, myaddr,
+					     todo_units * unit_size);
+    }
+  else
+    {
+      /* Reply describes memory byte by byte, each byte encoded as two
+	 hex characters.  */
+      p = rs->buf.data ();
+      decoded_bytes = hex2bin (p, myaddr, todo_units * unit_size);
+    }
   /* Return what we have.  Let higher layers handle partial reads.  */
   *xfered_len_units = (ULONGEST) (decoded_bytes / unit_size);
   return (*xfered_len_units != 0) ? TARGET_XFER_OK : TARGET_XFER_EOF;
@@ -14763,6 +14973,12 @@ Show the maximum size of the address (in bits) in a memory packet."), NULL,
   add_packet_config_cmd (&remote_protocol_packets[PACKET_no_resumed],
 			 "N stop reply", "no-resumed-stop-reply", 0);
 
+  add_packet_config_cmd (&remote_protocol_packets[PACKET_qThreadRegisters],
+			 "qThreadRegisters", "thread-registers", 0);
+
+  add_packet_config_cmd (&remote_protocol_packets[PACKET_x],
+			 "x", "binary-upload", 0);
+
   /* Assert that we've registered "set remote foo-packet" commands
      for all packet configs.  */
   {
@@ -25,6 +25,11 @@
 #include "gdbsupport/selftest.h"
 #include "objfiles.h"
 #include "exec.h"
+#include <algorithm>
+#if CXX_STD_THREAD
+#include "gdbsupport/thread-pool.h"
+#include <mutex>
+#endif
 
 #ifdef HAVE_SOURCE_HIGHLIGHT
 /* If Gnulib redirects 'open' and 'close' to its replacements
@@ -38,9 +43,31 @@
 #include <srchilite/langmap.h>
 #endif
 
-/* The number of source files we'll cache.  */
+/* The total size of the source text we'll cache.  The most recently
+   used file is always cached, whatever its size.  */
+
+#define MAX_CACHED_SIZE (32 * 1024 * 1024)
 
-#define MAX_ENTRIES 5
+/* Source files larger than this are highlighted in a worker thread,
+   if there are any.  */
+
+#define MAX_SYNC_HIGHLIGHT_SIZE (1024 * 1024)
+
+/* See source-cache.h.  */
+
+struct source_cache::pending_highlight
+{
+#if CXX_STD_THREAD
+  /* Becomes ready when the highlighting task has finished.  */
+  std::future<void> done;
+#endif
+
+  /* The highlighted text, or empty if highlighting failed.  This may
+     only be accessed once DONE is ready.  The task shares it rather
+     than this object, because the state behind DONE keeps the task
+     alive.  */
+  std::shared_ptr<std::string> result;
+};
 
 /* See source-cache.h.  */
 
@@ -147,10 +174,112 @@ get_language_name (enum language lang)
   return nullptr;
 }
 
+#if CXX_STD_THREAD
+/* The Source Highlight library may be used by several threads at
+   once, so uses of it are serialized with this mutex.  */
+
+static std::mutex highlighter_mutex;
+#endif
+
+/* Highlight CONTENTS, the text of the file FULLNAME, using the Source
+   Highlight language definition LANG_NAME.  On success, CONTENTS is
+   replaced by the highlighted text and true is returned.  Returns
+   false on failure.  This may be called from a worker thread.
+
+   If BUSY is not NULL and another thread is using the Source
+   Highlight library, don't wait for it: set *BUSY and return false
+   at once.  */
+
+static bool
+highlight_source (std::string *contents, const char *lang_name,
+		  const std::string &fullname, bool *busy = nullptr)
+{
+  /* The global source highlight object, or null if one was never
+     constructed.  This is stored here rather than in the class so
+     that we don't need to include anything or do conditional
+     compilation in source-cache.h.  */
+  static srchilite::SourceHighlight *highlighter;
+
+#if CXX_STD_THREAD
+  std::unique_lock<std::mutex> lock (highlighter_mutex, std::defer_lock);
+  if (busy == nullptr)
+    lock.lock ();
+  else if (!lock.try_lock ())
+    {
+      *busy = true;
+      return false;
+    }
+#endif
+
+  try
+    {
+      if (highlighter == nullptr)
+	{
+	  highlighter = new srchilite::SourceHighlight ("esc.outlang");
+	  highlighter->setStyleFile ("esc.style");
+	}
+
+      std::istringstream input (*contents);
+      std::ostringstream output;
+      highlighter->highlight (input, output, lang_name, fullname);
+      *contents = output.str ();
+      return true;
+    }
+  catch (...)
+    {
+      /* Source Highlight will throw an exception if highlighting
+	 fails.  One possible reason it can fail is if the language is
+	 unknown -- which matters to gdb because Rust support wasn't
+	 added until after 3.1.8.  Ignore exceptions here and fall
+	 back to un-highlighted text. */
+      return false;
+    }
+}
+
 #endif /* HAVE_SOURCE_HIGHLIGHT */
 
 /* See source-cache.h.  */
 
+void
+source_cache::finish_highlighting (source_text *text)
+{
+#if CXX_STD_THREAD
+  if (text->pending == nullptr
+      || (text->pending->done.wait_for (std::chrono::seconds (0))
+	  != std::future_status::ready))
+    return;
+
+  if (!text->pending->result->empty ())
+    text->contents = std::move (*text->pending->result);
+  else
+    {
+      gdb::optional<std::string> ext_contents;
+      ext_contents = ext_lang_colorize (text->fullname, text->contents);
+      if (ext_contents.has_value ())
+	text->contents = std::move (*ext_contents);
+    }
+  text->pending.reset ();
+#endif
+}
+
+/* See source-cache.h.  */
+
+void
+source_cache::shrink ()
+{
+  size_t total = 0;
+  for (const source_text &text : m_source_map)
+    total += text.contents.size ();
+
+  while (m_source_map.size () > 1 && total > MAX_CACHED_SIZE)
+    {
+      total -= m_source_map.front ().contents.size ();
+      m_source_map.erase (m_source_map.begin ());
+    }
+}
+
+/* See source-cache.h.  */
+
 bool
 source_cache::ensure (struct symtab *s)
 {
@@ -166,12 +295,19 @@ source_cache::ensure (struct symtab *s)
 	     without also clearing the contents cache.  */
 	  gdb_assert (m_offset_cache.find (fullname)
 		      != m_offset_cache.end ());
-	  /* Not strictly LRU, but at least ensure that the most
-	     recently used entry is always the last candidate for
-	     deletion.  Note that this property is relied upon by at
-	     least one caller.  */
+	  /* Move the entry to the end, keeping the others in order,
+	     so that the entries are sorted from the least to the most
+	     recently used.  Note that at least one caller relies on the
+	     most recently used entry being last.  */
 	  if (i != size - 1)
-	    std::swap (m_source_map[i], m_source_map[size - 1]);
+	    std::rotate (m_source_map.begin () + i,
+			 m_source_map.begin () + i + 1,
+			 m_source_map.end ());
+	  if (m_source_map.back ().pending != nullptr)
+	    {
+	      finish_highlighting (&m_source_map.back ());
+	      shrink ();
+	    }
 	  return true;
 	}
     }
@@ -187,6 +323,7 @@ source_cache::ensure (struct symtab *s)
       return false;
     }
 
+  std::shared_ptr<pending_highlight> pending;
   if (source_styling && gdb_stdout->can_emit_style_escape ())
     {
 #ifdef HAVE_SOURCE_HIGHLIGHT
@@ -194,35 +331,47 @@ source_cache::ensure (struct symtab *s)
       const char *lang_name = get_language_name (SYMTAB_LANGUAGE (s));
       if (lang_name != nullptr)
 	{
-	  /* The global source highlight object, or null if one was
-	     never constructed.  This is stored here rather than in
-	     the class so that we don't need to include anything or do
-	     conditional compilation in source-cache.h.  */
-	  static srchilite::SourceHighlight *highlighter;
-
-	  try
+#if CXX_STD_THREAD
+	  /* Highlight CONTENTS in the background, and show the plain
+	     text until that is done.  */
+	  auto highlight_in_background = [&] ()
 	    {
-	      if (highlighter == nullptr)
-		{
-		  highlighter = new srchilite::SourceHighlight ("esc.outlang");
-		  highlighter->setStyleFile ("esc.style");
-		}
-
-	      std::istringstream input (contents);
-	      std::ostringstream output;
-	      highlighter->highlight (input, output, lang_name, fullname);
-	      contents = output.str ();
+	      std::shared_ptr<std::string> highlighted
+		= std::make_shared<std::string> ();
+
+	      pending = std::make_shared<pending_highlight> ();
+	      pending->result = highlighted;
+	      pending->done = gdb::thread_pool::g_thread_pool->post_task
+		([=] () mutable
+		 {
+		   if (highlight_source (&contents, lang_name, fullname))
+		     *highlighted = std::move (contents);
+		   else
+		     std::string ().swap (contents);
+		 });
 	      already_styled = true;
-	    }
-	  catch (...)
+	    };
+
+	  /* Highlighting a large file can take a long time, so do it in
+	     the background if we can.  */
+	  if (contents.size () > MAX_SYNC_HIGHLIGHT_SIZE
+	      && gdb::thread_pool::g_thread_pool->thread_count () > 0)
+	    highlight_in_background ();
+	  else
 	    {
-	      /* Source Highlight will throw an exception if
-		 highlighting fails.  One possible reason it can fail
-		 is if the language is unknown -- which matters to gdb
-		 because Rust support wasn't added until after 3.1.8.
-		 Ignore exceptions here and fall back to
-		 un-highlighted text. */
+	      /* Don't make a small file wait until a large one has been
+		 highlighted in the background; queue it behind that
+		 one instead.  */
+	      bool busy = false;
+
+	      already_styled = highlight_source (&contents, lang_name,
+						 fullname, &busy);
+	      if (busy)
+		highlight_in_background ();
 	    }
+#else
+	  already_styled = highlight_source (&contents, lang_name, fullname);
+#endif
 	}
 
       if (!already_styled)
@@ -235,11 +384,10 @@ source_cache::ensure (struct symtab *s)
 	}
     }
 
-  source_text result = { std::move (fullname), std::move (contents) };
+  source_text result = { std::move (fullname), std::move (contents),
+			  std::move (pending) };
   m_source_map.push_back (std::move (result));
-
-  if (m_source_map.size () > MAX_ENTRIES)
-    m_source_map.erase (m_source_map.begin ());
+  shrink ();
 
   return true;
 }
@@ -19,17 +19,21 @@
 #ifndef SOURCE_CACHE_H
 #define SOURCE_CACHE_H
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
 /* This caches two things related to source files.
 
    First, it caches highlighted source text, keyed by the source
-   file's full name.  A size-limited LRU cache is used.
+   file's full name.  An LRU cache limited by the total size of the
+   text is used.
 
    Highlighting depends on the GNU Source Highlight library.  When not
    available or when highlighting fails for some reason, this cache
-   will instead store the un-highlighted source text.
+   will instead store the un-highlighted source text.  Large files are
+   highlighted in a worker thread when possible; until that finishes,
+   the un-highlighted text is stored.
 
    Second, this will cache the file offsets corresponding to the start
    of each line of a source file.  This cache is not size-limited.  */
@@ -70,6 +74,10 @@ class source_cache
 
 private:
 
+  /* Highlighting of a source file that is being done in the
+     background.  This is defined in source-cache.c.  */
+  struct pending_highlight;
+
   /* One element in the cache.  */
   struct source_text
   {
@@ -77,6 +85,9 @@ class source_cache
     std::string fullname;
     /* The contents of the file.  */
     std::string contents;
+    /* If the contents are being highlighted in the background, the
+       state of that work.  Otherwise NULL.  */
+    std::shared_ptr<pending_highlight> pending;
   };
 
   /* A helper function for get_source_lines reads a source file.
@@ -89,6 +100,15 @@ class source_cache
      into both caches.  Returns false on error.  */
   bool ensure (struct symtab *s);
 
+  /* If TEXT was being highlighted in the background and that has
+     finished, store the result in TEXT.  */
+  void finish_highlighting (source_text *text);
+
+  /* Evict the least recently used entries until the cache fits in
+     its size limit.  The most recently used entry is never
+     evicted.  */
+  void shrink ();
+
   /* The contents of the source text cache.  */
   std::vector<source_text> m_source_map;
 
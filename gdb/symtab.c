@@ -71,6 +71,11 @@
 #include "gdbsupport/gdb_string_view.h"
 #include "gdbsupport/pathstuff.h"
 #include "gdbsupport/common-utils.h"
+#include "gdbsupport/parallel-for.h"
+
+#if CXX_STD_THREAD
+#include <mutex>
+#endif
 
 /* Forward declarations for local functions.  */
 
@@ -134,6 +139,17 @@ static const program_space_key<main_info> main_progspace_key;
    there's no point in allowing a user typo to make gdb consume all memory.  */
 #define MAX_SYMBOL_CACHE_SIZE (1024*1024)
 
+/* The number of slots in each set of the symbol cache.  A lookup may
+   be recorded in any slot of the set selected by its hash, the least
+   recently used slot being reused first.  This makes evicting a live
+   entry because of a hash collision much less likely than with a
+   direct-mapped cache.  */
+#define SYMBOL_CACHE_WAYS 4
+
+/* The maximum number of failed lookups in individual objfiles that
+   are recorded, as a multiple of the symbol cache size.  */
+#define OBJFILE_MISSES_PER_SLOT 16
+
 /* symbol_cache_lookup returns this if a previous lookup failed to find the
    symbol in any objfile.  */
 #define SYMBOL_LOOKUP_FAILED \
@@ -202,15 +218,27 @@ struct block_symbol_cache
   unsigned int misses;
   unsigned int collisions;
 
-  /* SYMBOLS is a variable length array of this size.
+  /* The requested number of slots.
      One can imagine that in general one cache (global/static) should be a
      fraction of the size of the other, but there's no data at the moment
      on which to decide.  */
   unsigned int size;
 
+  /* The number of sets.  SYMBOLS is a variable length array of
+     NSETS * SYMBOL_CACHE_WAYS slots, which is SIZE rounded up.  */
+  unsigned int nsets;
+
   struct symbol_cache_slot symbols[1];
 };
 
+/* Return the number of slots of BSC.  */
+
+static unsigned int
+symbol_cache_nslots (const struct block_symbol_cache *bsc)
+{
+  return bsc->nsets * SYMBOL_CACHE_WAYS;
+}
+
 /* Clear all slots of BSC and free BSC.  */
 
 static void
@@ -218,12 +246,67 @@ destroy_block_symbol_cache (struct block_symbol_cache *bsc)
 {
   if (bsc != nullptr)
     {
-      for (unsigned int i = 0; i < bsc->size; i++)
+      for (unsigned int i = 0; i < symbol_cache_nslots (bsc); i++)
 	symbol_cache_clear_slot (&bsc->symbols[i]);
       xfree (bsc);
     }
 }
 
+/* A lookup in a single objfile, by lookup_symbol_in_objfile, that
+   found nothing.  Unlike the failed lookups recorded in the block
+   caches, which cover all objfiles, these stay valid when other
+   objfiles are added.  */
+
+struct objfile_symbol_miss
+{
+  const struct objfile *objfile;
+  enum block_enum block_index;
+  domain_enum domain;
+  /* The name looked up.  This is owned by the entry once it is in
+     the table.  */
+  const char *name;
+};
+
+/* Hash function for objfile_symbol_miss.  */
+
+static hashval_t
+hash_objfile_symbol_miss (const void *p)
+{
+  const struct objfile_symbol_miss *miss
+    = (const struct objfile_symbol_miss *) p;
+
+  return (htab_hash_pointer (miss->objfile)
+	  + htab_hash_string (miss->name)
+	  + miss->domain * 7 + miss->block_index);
+}
+
+/* Equality function for objfile_symbol_miss.  */
+
+static int
+eq_objfile_symbol_miss (const void *a, const void *b)
+{
+  const struct objfile_symbol_miss *ma
+    = (const struct objfile_symbol_miss *) a;
+  const struct objfile_symbol_miss *mb
+    = (const struct objfile_symbol_miss *) b;
+
+  return (ma->objfile == mb->objfile
+	  && ma->block_index == mb->block_index
+	  && ma->domain == mb->domain
+	  && strcmp (ma->name, mb->name) == 0);
+}
+
+/* Deletion function for objfile_symbol_miss.  */
+
+static void
+del_objfile_symbol_miss (void *p)
+{
+  struct objfile_symbol_miss *miss = (struct objfile_symbol_miss *) p;
+
+  xfree ((char *) miss->name);
+  xfree (miss);
+}
+
 /* The symbol cache.
 
    Searching for symbols in the static and global blocks over multiple objfiles
@@ -246,6 +329,13 @@ struct symbol_cache
 
   struct block_symbol_cache *global_symbols = nullptr;
   struct block_symbol_cache *static_symbols = nullptr;
+
+  /* Failed lookups in individual objfiles, of objfile_symbol_miss
+     entries.  This is NULL when the cache is disabled.  */
+  htab_up objfile_misses;
+
+  /* The number of lookups answered from OBJFILE_MISSES.  */
+  unsigned int objfile_miss_hits = 0;
 };
 
 /* Program space key for finding its symbol cache.  */
@@ -1215,8 +1305,11 @@ eq_symbol_entry (const struct symbol_cache_slot *slot,
 static size_t
 symbol_cache_byte_size (unsigned int size)
 {
+  unsigned int nslots
+    = (size + SYMBOL_CACHE_WAYS - 1) / SYMBOL_CACHE_WAYS * SYMBOL_CACHE_WAYS;
+
   return (sizeof (struct block_symbol_cache)
-	  + ((size - 1) * sizeof (struct symbol_cache_slot)));
+	  + ((nslots - 1) * sizeof (struct symbol_cache_slot)));
 }
 
 /* Resize CACHE.  */
@@ -1240,10 +1333,13 @@ resize_symbol_cache (struct symbol_cache *cache, unsigned int new_size)
     {
       cache->global_symbols = NULL;
       cache->static_symbols = NULL;
+      cache->objfile_misses.reset ();
     }
   else
     {
       size_t total_size = symbol_cache_byte_size (new_size);
+      unsigned int nsets
+	= (new_size + SYMBOL_CACHE_WAYS - 1) / SYMBOL_CACHE_WAYS;
 
       cache->global_symbols
 	= (struct block_symbol_cache *) xcalloc (1, total_size);
@@ -1251,6 +1347,15 @@ resize_symbol_cache (struct symbol_cache *cache, unsigned int new_size)
 	= (struct block_symbol_cache *) xcalloc (1, total_size);
       cache->global_symbols->size = new_size;
       cache->static_symbols->size = new_size;
+      cache->global_symbols->nsets = nsets;
+      cache->static_symbols->nsets = nsets;
+      if (cache->objfile_misses == nullptr)
+	cache->objfile_misses.reset
+	  (htab_create_alloc (127, hash_objfile_symbol_miss,
+			      eq_objfile_symbol_miss, del_objfile_symbol_miss,
+			      xcalloc, xfree));
+      else
+	htab_empty (cache->objfile_misses.get ());
     }
 }
 
@@ -1311,8 +1416,9 @@ set_symbol_cache_size_handler (const char *args, int from_tty,
    The result is the symbol if found, SYMBOL_LOOKUP_FAILED if a previous lookup
    failed (and thus this one will too), or NULL if the symbol is not present
    in the cache.
-   *BSC_PTR and *SLOT_PTR are set to the cache and slot of the symbol, which
-   can be used to save the result of a full lookup attempt.  */
+   *BSC_PTR and *SLOT_PTR are set to the cache and the first slot of the set
+   of the symbol, which can be used to save the result of a full lookup
+   attempt.  */
 
 static struct block_symbol
 symbol_cache_lookup (struct symbol_cache *cache,
@@ -1337,13 +1443,22 @@ symbol_cache_lookup (struct symbol_cache *cache,
     }
 
   hash = hash_symbol_entry (objfile_context, name, domain);
-  slot = bsc->symbols + hash % bsc->size;
+  struct symbol_cache_slot *set
+    = bsc->symbols + (hash % bsc->nsets) * SYMBOL_CACHE_WAYS;
 
   *bsc_ptr = bsc;
-  *slot_ptr = slot;
+  *slot_ptr = set;
 
-  if (eq_symbol_entry (slot, objfile_context, name, domain))
+  for (int i = 0; i < SYMBOL_CACHE_WAYS; ++i)
     {
+      if (!eq_symbol_entry (&set[i], objfile_context, name, domain))
+	continue;
+
+      /* Keep the set ordered from the most to the least recently
+	 used slot.  */
+      std::rotate (set, set + i, set + i + 1);
+      slot = set;
+
       if (symbol_lookup_debug)
 	fprintf_unfiltered (gdb_stdlog,
 			    "%s block symbol cache hit%s for %s, %s\n",
@@ -1370,48 +1485,66 @@ symbol_cache_lookup (struct symbol_cache *cache,
   return {};
 }
 
-/* Mark SYMBOL as found in SLOT.
+/* Return a free slot of BSC's set SET for a new entry, evicting the
+   least recently used entry of the set if needed.  The slot is made
+   the most recently used one.  */
+
+static struct symbol_cache_slot *
+symbol_cache_new_slot (struct block_symbol_cache *bsc,
+		       struct symbol_cache_slot *set)
+{
+  int i;
+
+  for (i = 0; i < SYMBOL_CACHE_WAYS - 1; ++i)
+    if (set[i].state == SYMBOL_SLOT_UNUSED)
+      break;
+
+  if (set[i].state != SYMBOL_SLOT_UNUSED)
+    {
+      ++bsc->collisions;
+      symbol_cache_clear_slot (&set[i]);
+    }
+
+  std::rotate (set, set + i, set + i + 1);
+  return set;
+}
+
+/* Mark SYMBOL as found in the set of slots SET.
    OBJFILE_CONTEXT is the current objfile when the lookup was done, or NULL
    if it's not needed to distinguish lookups (STATIC_BLOCK).  It is *not*
    necessarily the objfile the symbol was found in.  */
 
 static void
 symbol_cache_mark_found (struct block_symbol_cache *bsc,
-			 struct symbol_cache_slot *slot,
+			 struct symbol_cache_slot *set,
 			 struct objfile *objfile_context,
 			 struct symbol *symbol,
 			 const struct block *block)
 {
   if (bsc == NULL)
     return;
-  if (slot->state != SYMBOL_SLOT_UNUSED)
-    {
-      ++bsc->collisions;
-      symbol_cache_clear_slot (slot);
-    }
+
+  struct symbol_cache_slot *slot = symbol_cache_new_slot (bsc, set);
   slot->state = SYMBOL_SLOT_FOUND;
   slot->objfile_context = objfile_context;
   slot->value.found.symbol = symbol;
   slot->value.found.block = block;
 }
 
-/* Mark symbol NAME, DOMAIN as not found in SLOT.
+/* Mark symbol NAME, DOMAIN as not found in the set of slots SET.
    OBJFILE_CONTEXT is the current objfile when the lookup was done, or NULL
    if it's not needed to distinguish lookups (STATIC_BLOCK).  */
 
 static void
 symbol_cache_mark_not_found (struct block_symbol_cache *bsc,
-			     struct symbol_cache_slot *slot,
+			     struct symbol_cache_slot *set,
 			     struct objfile *objfile_context,
 			     const char *name, domain_enum domain)
 {
   if (bsc == NULL)
     return;
-  if (slot->state != SYMBOL_SLOT_UNUSED)
-    {
-      ++bsc->collisions;
-      symbol_cache_clear_slot (slot);
-    }
+
+  struct symbol_cache_slot *slot = symbol_cache_new_slot (bsc, set);
   slot->state = SYMBOL_SLOT_NOT_FOUND;
   slot->objfile_context = objfile_context;
   slot->value.not_found.name = xstrdup (name);
@@ -1439,7 +1572,8 @@ symbol_cache_flush (struct program_space *pspace)
      This is important for performance during the startup of a program linked
      with 100s (or 1000s) of shared libraries.  */
   if (cache->global_symbols->misses == 0
-      && cache->static_symbols->misses == 0)
+      && cache->static_symbols->misses == 0
+      && htab_elements (cache->objfile_misses.get ()) == 0)
     return;
 
   gdb_assert (cache->global_symbols->size == symbol_cache_size);
@@ -1451,9 +1585,10 @@ symbol_cache_flush (struct program_space *pspace)
 	= pass == 0 ? cache->global_symbols : cache->static_symbols;
       unsigned int i;
 
-      for (i = 0; i < bsc->size; ++i)
+      for (i = 0; i < symbol_cache_nslots (bsc); ++i)
 	symbol_cache_clear_slot (&bsc->symbols[i]);
     }
+  htab_empty (cache->objfile_misses.get ());
 
   cache->global_symbols->hits = 0;
   cache->global_symbols->misses = 0;
@@ -1461,6 +1596,82 @@ symbol_cache_flush (struct program_space *pspace)
   cache->static_symbols->hits = 0;
   cache->static_symbols->misses = 0;
   cache->static_symbols->collisions = 0;
+  cache->objfile_miss_hits = 0;
+}
+
+/* Remove the entries of the symbol cache of PSPACE that record failed
+   lookups over all objfiles.  This is all that needs to be done when
+   an objfile is added at the end of the search order: it can't hide
+   a symbol that was found in an objfile before it, and the failed
+   lookups in individual objfiles stay valid.  */
+
+static void
+symbol_cache_flush_not_found (struct program_space *pspace)
+{
+  struct symbol_cache *cache = symbol_cache_key.get (pspace);
+
+  if (cache == NULL || cache->global_symbols == NULL)
+    return;
+
+  for (int pass = 0; pass < 2; ++pass)
+    {
+      struct block_symbol_cache *bsc
+	= pass == 0 ? cache->global_symbols : cache->static_symbols;
+
+      for (unsigned int i = 0; i < symbol_cache_nslots (bsc); ++i)
+	if (bsc->symbols[i].state == SYMBOL_SLOT_NOT_FOUND)
+	  symbol_cache_clear_slot (&bsc->symbols[i]);
+    }
+}
+
+/* Return true if a lookup of NAME, DOMAIN in block BLOCK_INDEX of
+   OBJFILE is recorded in CACHE as having failed.  */
+
+static bool
+symbol_cache_objfile_miss_p (struct symbol_cache *cache,
+			     const struct objfile *objfile,
+			     enum block_enum block_index,
+			     const char *name, domain_enum domain)
+{
+  if (cache->objfile_misses == nullptr || name == NULL)
+    return false;
+
+  struct objfile_symbol_miss key = { objfile, block_index, domain, name };
+  if (htab_find (cache->objfile_misses.get (), &key) == NULL)
+    return false;
+
+  ++cache->objfile_miss_hits;
+  return true;
+}
+
+/* Record in CACHE that a lookup of NAME, DOMAIN in block BLOCK_INDEX
+   of OBJFILE failed.  */
+
+static void
+symbol_cache_mark_objfile_miss (struct symbol_cache *cache,
+				const struct objfile *objfile,
+				enum block_enum block_index,
+				const char *name, domain_enum domain)
+{
+  if (cache->objfile_misses == nullptr || name == NULL)
+    return;
+
+  htab_t misses = cache->objfile_misses.get ();
+
+  /* Keep the table's memory bounded.  */
+  if (htab_elements (misses) >= OBJFILE_MISSES_PER_SLOT * symbol_cache_size)
+    htab_empty (misses);
+
+  struct objfile_symbol_miss key = { objfile, block_index, domain, name };
+  void **slot = htab_find_slot (misses, &key, INSERT);
+  if (*slot == NULL)
+    {
+      struct objfile_symbol_miss *miss = XNEW (struct objfile_symbol_miss);
+
+      *miss = key;
+      miss->name = xstrdup (name);
+      *slot = miss;
+    }
 }
 
 /* Dump CACHE.  */
@@ -1487,7 +1698,7 @@ symbol_cache_dump (const struct symbol_cache *cache)
       else
 	printf_filtered ("Static symbols:\n");
 
-      for (i = 0; i < bsc->size; ++i)
+      for (i = 0; i < symbol_cache_nslots (bsc); ++i)
 	{
 	  const struct symbol_cache_slot *slot = &bsc->symbols[i];
 
@@ -1584,6 +1795,11 @@ symbol_cache_stats (struct symbol_cache *cache)
       printf_filtered ("  misses:     %u\n", bsc->misses);
       printf_filtered ("  collisions: %u\n", bsc->collisions);
     }
+
+  printf_filtered ("Objfile lookup failure cache stats:\n");
+  printf_filtered ("  entries:    %u\n",
+		   (unsigned int) htab_elements (cache->objfile_misses.get ()));
+  printf_filtered ("  hits:       %u\n", cache->objfile_miss_hits);
 }
 
 /* The "mt print symbol-cache-statistics" command.  */
@@ -1615,6 +1831,19 @@ maintenance_print_symbol_cache_statistics (const char *args, int from_tty)
 static void
 symtab_new_objfile_observer (struct objfile *objfile)
 {
+  /* An objfile appended to the list of objfiles comes last in the
+     search order, so it can only affect lookups that failed.  A
+     separate debug objfile, though, is searched along with its
+     parent, which may come earlier.  */
+  if (objfile != NULL
+      && objfile->separate_debug_objfile_backlink == NULL
+      && !objfile->pspace->objfiles_list.empty ()
+      && objfile->pspace->objfiles_list.back ().get () == objfile)
+    {
+      symbol_cache_flush_not_found (objfile->pspace);
+      return;
+    }
+
   /* Ideally we'd use OBJFILE->pspace, but OBJFILE may be NULL.  */
   symbol_cache_flush (current_program_space);
 }
@@ -2505,6 +2734,16 @@ lookup_symbol_in_objfile (struct objfile *objfile, enum block_enum block_index,
 			  name, domain_name (domain));
     }
 
+  struct symbol_cache *cache = get_symbol_cache (objfile->pspace);
+  if (symbol_cache_objfile_miss_p (cache, objfile, block_index, name, domain))
+    {
+      if (symbol_lookup_debug)
+	fprintf_unfiltered (gdb_stdlog,
+			    "lookup_symbol_in_objfile (...) = NULL"
+			    " (cached)\n");
+      return {};
+    }
+
   result = lookup_symbol_in_objfile_symtabs (objfile, block_index,
 					     name, domain);
   if (result.symbol != NULL)
@@ -2521,6 +2760,8 @@ lookup_symbol_in_objfile (struct objfile *objfile, enum block_enum block_index,
 
   result = lookup_symbol_via_quick_fns (objfile, block_index,
 					name, domain);
+  if (result.symbol == NULL)
+    symbol_cache_mark_objfile_miss (cache, objfile, block_index, name, domain);
   if (symbol_lookup_debug)
     {
       fprintf_unfiltered (gdb_stdlog,
@@ -4589,6 +4830,52 @@ global_symbol_searcher::expand_symtabs
 
 /* See symtab.h.  */
 
+bool
+global_symbol_searcher::is_matching_symbol
+	(struct symbol *sym,
+	 const gdb::optional<compiled_regex> &preg,
+	 const gdb::optional<compiled_regex> &treg) const
+{
+  enum search_domain kind = m_kind;
+  struct symtab *real_symtab = symbol_symtab (sym);
+
+  /* Check first sole REAL_SYMTAB->FILENAME.  It does not need to be a
+     substring of symtab_to_fullname as it may contain "./" etc.  */
+  return ((file_matches (real_symtab->filename, filenames, false)
+	   || ((basenames_may_differ
+		|| file_matches (lbasename (real_symtab->filename),
+				 filenames, true))
+	       && file_matches (symtab_to_fullname (real_symtab),
+				filenames, false)))
+	  && ((!preg.has_value ()
+	       || preg->exec (sym->natural_name (), 0,
+			      NULL, 0) == 0)
+	      && ((kind == VARIABLES_DOMAIN
+		   && SYMBOL_CLASS (sym) != LOC_TYPEDEF
+		   && SYMBOL_CLASS (sym) != LOC_UNRESOLVED
+		   && SYMBOL_CLASS (sym) != LOC_BLOCK
+		   /* LOC_CONST can be used for more than just enums,
+		      e.g., c++ static const members.  We only want to
+		      skip enums here.  */
+		   && !(SYMBOL_CLASS (sym) == LOC_CONST
+			&& (SYMBOL_TYPE (sym)->code ()
+			    == TYPE_CODE_ENUM))
+		   && (!treg.has_value ()
+		       || treg_matches_sym_type_name (*treg, sym)))
+		  || (kind == FUNCTIONS_DOMAIN
+		      && SYMBOL_CLASS (sym) == LOC_BLOCK
+		      && (!treg.has_value ()
+			  || treg_matches_sym_type_name (*treg, sym)))
+		  || (kind == TYPES_DOMAIN
+		      && SYMBOL_CLASS (sym) == LOC_TYPEDEF
+		      && SYMBOL_DOMAIN (sym) != MODULE_DOMAIN)
+		  || (kind == MODULES_DOMAIN
+		      && SYMBOL_DOMAIN (sym) == MODULE_DOMAIN
+		      && SYMBOL_LINE (sym) != 0))));
+}
+
+/* See symtab.h.  */
+
 bool
 global_symbol_searcher::add_matching_symbols
 	(objfile *objfile,
@@ -4596,8 +4883,6 @@ global_symbol_searcher::add_matching_symbols
 	 const gdb::optional<compiled_regex> &treg,
 	 std::set<symbol_search> *result_set) const
 {
-  enum search_domain kind = m_kind;
-
   /* Add matching symbols (if not already present).  */
   for (compunit_symtab *cust : objfile->compunits ())
     {
@@ -4611,46 +4896,9 @@ global_symbol_searcher::add_matching_symbols
 
 	  ALL_BLOCK_SYMBOLS (b, iter, sym)
 	    {
-	      struct symtab *real_symtab = symbol_symtab (sym);
-
 	      QUIT;
 
-	      /* Check first sole REAL_SYMTAB->FILENAME.  It does
-		 not need to be a substring of symtab_to_fullname as
-		 it may contain "./" etc.  */
-	      if ((file_matches (real_symtab->filename, filenames, false)
-		   || ((basenames_may_differ
-			|| file_matches (lbasename (real_symtab->filename),
-					 filenames, true))
-		       && file_matches (symtab_to_fullname (real_symtab),
-					filenames, false)))
-		  && ((!preg.has_value ()
-		       || preg->exec (sym->natural_name (), 0,
-				      NULL, 0) == 0)
-		      && ((kind == VARIABLES_DOMAIN
-			   && SYMBOL_CLASS (sym) != LOC_TYPEDEF
-			   && SYMBOL_CLASS (sym) != LOC_UNRESOLVED
-			   && SYMBOL_CLASS (sym) != LOC_BLOCK
-			   /* LOC_CONST can be used for more than
-			      just enums, e.g., c++ static const
-			      members.  We only want to skip enums
-			      here.  */
-			   && !(SYMBOL_CLASS (sym) == LOC_CONST
-				&& (SYMBOL_TYPE (sym)->code ()
-				    == TYPE_CODE_ENUM))
-			   && (!treg.has_value ()
-			       || treg_matches_sym_type_name (*treg, sym)))
-			  || (kind == FUNCTIONS_DOMAIN
-			      && SYMBOL_CLASS (sym) == LOC_BLOCK
-			      && (!treg.has_value ()
-				  || treg_matches_sym_type_name (*treg,
-								 sym)))
-			  || (kind == TYPES_DOMAIN
-			      && SYMBOL_CLASS (sym) == LOC_TYPEDEF
-			      && SYMBOL_DOMAIN (sym) != MODULE_DOMAIN)
-			  || (kind == MODULES_DOMAIN
-			      && SYMBOL_DOMAIN (sym) == MODULE_DOMAIN
-			      && SYMBOL_LINE (sym) != 0))))
+	      if (is_matching_symbol (sym, preg, treg))
 		{
 		  if (result_set->size () < m_max_search_results)
 		    {
@@ -4671,6 +4919,109 @@ global_symbol_searcher::add_matching_symbols
 
 /* See symtab.h.  */
 
+std::vector<symbol_search>
+global_symbol_searcher::parallel_search_symbols
+	(const gdb::optional<compiled_regex> &preg) const
+{
+  gdb_assert (filenames.empty ());
+  gdb_assert (m_max_search_results == SIZE_MAX);
+
+  std::vector<compunit_symtab *> compunits;
+  for (objfile *objfile : current_program_space->objfiles ())
+    for (compunit_symtab *cust : objfile->compunits ())
+      compunits.push_back (cust);
+
+  /* The worker threads may only read symbol names.  The first request
+     for the natural name of an Ada symbol decodes it and caches the
+     result in the symbol, allocating it on the objfile obstack or in
+     a global table, neither of which is thread-safe.  So decode those
+     names here, in the main thread.  All symbols of a compunit are in
+     its language.  */
+  for (compunit_symtab *cust : compunits)
+    if (compunit_language (cust) == language_ada)
+      {
+	const struct blockvector *bv = COMPUNIT_BLOCKVECTOR (cust);
+
+	for (block_enum block : { GLOBAL_BLOCK, STATIC_BLOCK })
+	  {
+	    struct block_iterator iter;
+	    struct symbol *sym;
+
+	    ALL_BLOCK_SYMBOLS (BLOCKVECTOR_BLOCK (bv, block), iter, sym)
+	      sym->natural_name ();
+	  }
+      }
+
+  /* The matches of each range of compunits, sorted, along with the
+     index of the range's first compunit.  */
+  std::vector<std::pair<size_t, std::vector<symbol_search>>> partial_results;
+#if CXX_STD_THREAD
+  std::mutex results_mutex;
+#endif
+
+  /* Note that nothing here may throw, as the other threads would keep
+     using this frame.  Matching a symbol does not, without a type
+     regexp or file names.  */
+  gdb::optional<compiled_regex> no_treg;
+  gdb::parallel_for_each
+    (compunits.begin (), compunits.end (),
+     [&] (std::vector<compunit_symtab *>::iterator start,
+	  std::vector<compunit_symtab *>::iterator end)
+     {
+       std::vector<symbol_search> matches;
+
+       for (auto iter = start; iter != end; ++iter)
+	 {
+	   const struct blockvector *bv = COMPUNIT_BLOCKVECTOR (*iter);
+
+	   for (block_enum block : { GLOBAL_BLOCK, STATIC_BLOCK })
+	     {
+	       struct block_iterator biter;
+	       struct symbol *sym;
+	       const struct block *b = BLOCKVECTOR_BLOCK (bv, block);
+
+	       ALL_BLOCK_SYMBOLS (b, biter, sym)
+		 if (is_matching_symbol (sym, preg, no_treg))
+		   matches.emplace_back (block, sym);
+	     }
+	 }
+
+       /* A stable sort, so that the first of several equal symbols
+	  is kept below, as a sequential search would.  */
+       std::stable_sort (matches.begin (), matches.end ());
+
+#if CXX_STD_THREAD
+       std::lock_guard<std::mutex> guard (results_mutex);
+#endif
+       partial_results.emplace_back (start - compunits.begin (),
+				     std::move (matches));
+     });
+
+  /* Merge the partial results in the order of the compunits.  */
+  std::sort (partial_results.begin (), partial_results.end (),
+	     [] (const std::pair<size_t, std::vector<symbol_search>> &a,
+		 const std::pair<size_t, std::vector<symbol_search>> &b)
+	     {
+	       return a.first < b.first;
+	     });
+
+  std::vector<symbol_search> result;
+  for (auto &partial : partial_results)
+    {
+      size_t middle = result.size ();
+
+      result.insert (result.end (), partial.second.begin (),
+		     partial.second.end ());
+      std::inplace_merge (result.begin (), result.begin () + middle,
+			  result.end ());
+    }
+  result.erase (std::unique (result.begin (), result.end ()), result.end ());
+
+  return result;
+}
+
+/* See symtab.h.  */
+
 bool
 global_symbol_searcher::add_matching_msymbols
 	(objfile *objfile, const gdb::optional<compiled_regex> &preg,
@@ -4779,24 +5130,45 @@ global_symbol_searcher::search () const
     }
 
   bool found_msymbol = false;
-  std::set<symbol_search> result_set;
-  for (objfile *objfile : current_program_space->objfiles ())
+  std::vector<symbol_search> result;
+#if CXX_STD_THREAD
+  /* Matching the symbols of big programs can take a long time.  When
+     it is safe, expand the symtabs first, and then match the symbols
+     in the worker threads.  Expanding symtabs can't be done in
+     parallel.  */
+  if (filenames.empty ()
+      && !treg.has_value ()
+      && m_max_search_results == SIZE_MAX
+      && gdb::thread_pool::g_thread_pool->thread_count () > 1)
     {
-      /* Expand symtabs within objfile that possibly contain matching
-	 symbols.  */
-      found_msymbol |= expand_symtabs (objfile, preg);
+      for (objfile *objfile : current_program_space->objfiles ())
+	found_msymbol |= expand_symtabs (objfile, preg);
 
-      /* Find matching symbols within OBJFILE and add them in to the
-	 RESULT_SET set.  Use a set here so that we can easily detect
-	 duplicates as we go, and can therefore track how many unique
-	 matches we have found so far.  */
-      if (!add_matching_symbols (objfile, preg, treg, &result_set))
-	break;
+      result = parallel_search_symbols (preg);
     }
+  else
+#endif
+    {
+      std::set<symbol_search> result_set;
+      for (objfile *objfile : current_program_space->objfiles ())
+	{
+	  /* Expand symtabs within objfile that possibly contain matching
+	     symbols.  */
+	  found_msymbol |= expand_symtabs (objfile, preg);
+
+	  /* Find matching symbols within OBJFILE and add them in to the
+	     RESULT_SET set.  Use a set here so that we can easily detect
+	     duplicates as we go, and can therefore track how many unique
+	     matches we have found so far.  */
+	  if (!add_matching_symbols (objfile, preg, treg, &result_set))
+	    break;
+	}
 
-  /* Convert the result set into a sorted result list, as std::set is
-     defined to be sorted then no explicit call to std::sort is needed.  */
-  std::vector<symbol_search> result (result_set.begin (), result_set.end ());
+      /* Convert the result set into a sorted result list, as std::set is
+	 defined to be sorted then no explicit call to std::sort is
+	 needed.  */
+      result.assign (result_set.begin (), result_set.end ());
+    }
 
   /* If there are no debug symbols, then add matching minsyms.  But if the
      user wants to see symbols matching a type regexp, then never give a
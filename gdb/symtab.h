@@ -2173,6 +2173,22 @@ class global_symbol_searcher
 			     const gdb::optional<compiled_regex> &treg,
 			     std::set<symbol_search> *result_set) const;
 
+  /* Return true if SYM, from a global or static block, is in one of
+     FILENAMES, matches PREG and TREG, and is of type M_KIND.  */
+  bool is_matching_symbol (struct symbol *sym,
+			   const gdb::optional<compiled_regex> &preg,
+			   const gdb::optional<compiled_regex> &treg) const;
+
+  /* Find the symbols in all the expanded symtabs of the current
+     program space that match PREG and M_KIND, using the worker
+     threads.  The result is sorted and free of duplicates, like the
+     result of add_matching_symbols.  This may only be used when there
+     are no FILENAMES, no type regexp and no limit on the number of
+     results, as only then is matching a symbol safe in a worker
+     thread.  */
+  std::vector<symbol_search> parallel_search_symbols
+    (const gdb::optional<compiled_regex> &preg) const;
+
   /* Add msymbols from OBJFILE that match PREG and M_KIND, to the results
      vector RESULTS.  Return false if we stop adding results early due to
      having already found too many results (based on max search results
@@ -1160,6 +1160,19 @@ make_scoped_restore_show_memory_breakpoints (int show)
   return make_scoped_restore (&show_memory_breakpoints, show);
 }
 
+/* Incremented by every write to a target.  See
+   target_write_generation.  */
+
+static unsigned int target_write_generation_counter;
+
+/* See target.h.  */
+
+unsigned int
+target_write_generation ()
+{
+  return target_write_generation_counter;
+}
+
 /* For docs see target.h, to_xfer_partial.  */
 
 enum target_xfer_status
@@ -1179,6 +1192,9 @@ target_xfer_partial (struct target_ops *ops,
     error (_("Writing to memory is not allowed (addr %s, len %s)"),
 	   core_addr_to_string_nz (offset), plongest (len));
 
+  if (writebuf != NULL)
+    target_write_generation_counter++;
+
   *xfered_len = 0;
 
   /* If this is a memory transfer, let the memory-specific code
@@ -3450,6 +3466,7 @@ target_store_registers (struct regcache *regcache, int regno)
   if (!may_write_registers)
     error (_("Writing to registers is not allowed (regno %d)"), regno);
 
+  target_write_generation_counter++;
   current_top_target ()->store_registers (regcache, regno);
   if (targetdebug)
     {
@@ -1460,6 +1460,13 @@ extern void target_fetch_registers (struct regcache *regcache, int regno);
 
 extern void target_store_registers (struct regcache *regcache, int regs);
 
+/* Return a number that changes whenever GDB writes to the registers,
+   memory or any other object of a target, whatever the path taken.
+   Callers that cache data read from the target can compare it with a
+   value saved earlier to tell whether the data may be stale.  */
+
+extern unsigned int target_write_generation ();
+
 /* Get ready to modify the registers array.  On machines which store
    individual registers, this doesn't need to do anything.  On machines
    which store all the registers in one fell swoop, this makes sure
@@ -0,0 +1,61 @@
+/* Copyright 2026 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* A mostly-zero anonymous region; gcore should leave its zero blocks
+   as holes in the core file.  */
+#define SPARSE_SIZE (16 * 1024 * 1024)
+
+char *sparse;
+
+/* A private mapping of a one-page file that extends three pages past
+   the end of the file.  Only its first page is readable.  */
+char *truncated;
+
+int
+main (int argc, char *argv[])
+{
+  long page = sysconf (_SC_PAGESIZE);
+  char *filename = argv[1];
+  int fd;
+
+  sparse = mmap (NULL, SPARSE_SIZE, PROT_READ | PROT_WRITE,
+		 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  assert (sparse != MAP_FAILED);
+  sparse[0] = 0x11;
+  sparse[SPARSE_SIZE / 2] = 0x22;
+  sparse[SPARSE_SIZE - 1] = 0x33;
+
+  fd = open (filename, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  assert (fd >= 0);
+  assert (ftruncate (fd, page) == 0);
+  truncated = mmap (NULL, 4 * page, PROT_READ | PROT_WRITE,
+		    MAP_PRIVATE, fd, 0);
+  assert (truncated != MAP_FAILED);
+  close (fd);
+  /* Dirty the first page so that the mapping is dumped.  */
+  truncated[0] = 0x44;
+
+  return 0; /* break-here */
+}
@@ -41,6 +41,8 @@ typedef struct s *PTR;
 
 enum e evalue = TWO;
 
+struct s sarray[3] = { { 1, 2 }, { 3, 4 }, { 5, 6 } };
+
 struct str
 {
   int length;
@@ -0,0 +1,51 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright 2026 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+unsigned char *buf;
+long page_size;
+
+static void
+done (void)
+{
+}
+
+int
+main (void)
+{
+  long i;
+
+  page_size = sysconf (_SC_PAGESIZE);
+
+  /* A readable page followed by an unreadable one.  */
+  buf = mmap (NULL, 2 * page_size, PROT_READ | PROT_WRITE,
+	      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buf == MAP_FAILED)
+    return 1;
+  if (mprotect (buf + page_size, page_size, PROT_NONE) != 0)
+    return 1;
+
+  /* Use every byte value, including those that binary packets must
+     escape.  */
+  for (i = 0; i < page_size; i++)
+    buf[i] = i * 7;
+
+  done ();
+  return 0;
+}
@@ -227,9 +227,27 @@ init_thread_list (void)
 	set_thread_exited (tp, 1);
 
       inf->thread_list = NULL;
+      inf->ptid_thread_map.clear ();
     }
 }
 
+/* Make INF's ptid_thread_map entry for PTID point at the first thread
+   of INF's thread list with that ptid, or remove it if there is no
+   such thread.  */
+
+static void
+refresh_ptid_thread_map (inferior *inf, ptid_t ptid)
+{
+  for (thread_info *tp : inf->threads ())
+    if (tp->ptid == ptid)
+      {
+	inf->ptid_thread_map[ptid] = tp;
+	return;
+      }
+
+  inf->ptid_thread_map.erase (ptid);
+}
+
 /* Allocate a new thread of inferior INF with target id PTID and add
    it to the thread list.  */
 
@@ -249,6 +267,11 @@ new_thread (struct inferior *inf, ptid_t ptid)
       last->next = tp;
     }
 
+  /* New threads go at the end of the list, so an existing entry for
+     the same ptid (e.g. an exited thread that could not be deleted
+     yet) stays first.  */
+  inf->ptid_thread_map.emplace (ptid, tp);
+
   return tp;
 }
 
@@ -284,6 +307,8 @@ add_thread_silent (process_stratum_target *targ, ptid_t ptid)
 
 	  /* Now reset its ptid, and reswitch inferior_ptid to it.  */
 	  new_thr->ptid = ptid;
+	  refresh_ptid_thread_map (new_thr->inf, null_ptid);
+	  refresh_ptid_thread_map (new_thr->inf, ptid);
 	  new_thr->state = THREAD_STOPPED;
 	  switch_to_thread (new_thr);
 
@@ -479,6 +504,10 @@ delete_thread_1 (thread_info *thr, bool silent)
   else
     tp->inf->thread_list = tp->next;
 
+  auto it = tp->inf->ptid_thread_map.find (tp->ptid);
+  if (it != tp->inf->ptid_thread_map.end () && it->second == tp)
+    refresh_ptid_thread_map (tp->inf, tp->ptid);
+
   delete tp;
 }
 
@@ -535,9 +564,9 @@ find_thread_ptid (process_stratum_target *targ, ptid_t ptid)
 struct thread_info *
 find_thread_ptid (inferior *inf, ptid_t ptid)
 {
-  for (thread_info *tp : inf->threads ())
-    if (tp->ptid == ptid)
-      return tp;
+  auto it = inf->ptid_thread_map.find (ptid);
+  if (it != inf->ptid_thread_map.end ())
+    return it->second;
 
   return NULL;
 }
@@ -807,6 +836,8 @@ thread_change_ptid (process_stratum_target *targ,
 
   tp = find_thread_ptid (inf, old_ptid);
   tp->ptid = new_ptid;
+  refresh_ptid_thread_map (inf, old_ptid);
+  refresh_ptid_thread_map (inf, new_ptid);
 
   gdb::observers::thread_ptid_changed.notify (old_ptid, new_ptid);
 }
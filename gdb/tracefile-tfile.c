@@ -34,6 +34,10 @@
 #include "gdbsupport/buffer.h"
 #include "gdbsupport/pathstuff.h"
 #include <algorithm>
+#include <map>
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 
 #ifndef O_LARGEFILE
 #define O_LARGEFILE 0
@@ -427,6 +431,42 @@ static int cur_data_size;
 int trace_regblock_size;
 static struct buffer trace_tdesc;
 
+/* If the trace file could be mapped into memory, the address and size
+   of the mapping.  TRACE_MAP_POS then stands in for TRACE_FD's seek
+   position.  */
+static const gdb_byte *trace_map;
+static size_t trace_map_size;
+static off_t trace_map_pos;
+
+/* An entry in the index of the trace file's traceframes.  */
+
+struct tfile_frame_entry
+{
+  /* Offset of the traceframe's data, just past its header.  */
+  off_t offset;
+
+  /* Size of the traceframe's data.  */
+  unsigned int data_size;
+
+  /* The target's number of the tracepoint that collected it.  */
+  short tpnum;
+};
+
+/* The index of the traceframes, by traceframe number.  It is built
+   by the first search for a traceframe.  */
+static std::vector<tfile_frame_entry> trace_frames;
+
+/* The numbers of the traceframes collected by each tracepoint, in
+   increasing order, keyed by the target's tracepoint number.  */
+static std::map<short, std::vector<int>> trace_frames_by_tpnum;
+
+/* True once TRACE_FRAMES has been built.  */
+static bool trace_frames_indexed;
+
+/* If the traceframes could not all be indexed, the error that stopped
+   the indexing.  */
+static std::string trace_frames_error;
+
 static void tfile_append_tdesc_line (const char *line);
 static void tfile_interp_line (char *line,
 			       struct uploaded_tp **utpp,
@@ -443,6 +483,16 @@ tfile_read (gdb_byte *readbuf, int size)
 {
   int gotten;
 
+  if (trace_map != NULL)
+    {
+      if (trace_map_pos < 0 || (size_t) trace_map_pos > trace_map_size
+	  || (size_t) size > trace_map_size - trace_map_pos)
+	error (_("Premature end of file while reading trace file"));
+      memcpy (readbuf, trace_map + trace_map_pos, size);
+      trace_map_pos += size;
+      return;
+    }
+
   gotten = read (trace_fd, readbuf, size);
   if (gotten < 0)
     perror_with_name (trace_filename);
@@ -450,6 +500,72 @@ tfile_read (gdb_byte *readbuf, int size)
     error (_("Premature end of file while reading trace file"));
 }
 
+/* Like lseek on TRACE_FD, but also works when the trace file is
+   mapped into memory.  WHENCE is either SEEK_SET or SEEK_CUR.  */
+
+static void
+tfile_seek (off_t offset, int whence)
+{
+  if (trace_map != NULL)
+    {
+      if (whence == SEEK_SET)
+	trace_map_pos = offset;
+      else
+	trace_map_pos += offset;
+    }
+  else
+    lseek (trace_fd, offset, whence);
+}
+
+/* Map the trace file into memory, if possible.  If this fails, the
+   trace file is read with `read' instead.  */
+
+static void
+tfile_map_file ()
+{
+#ifdef HAVE_MMAP
+  struct stat st;
+
+  if (fstat (trace_fd, &st) < 0 || st.st_size <= 0
+      || (uintmax_t) st.st_size > SIZE_MAX)
+    return;
+
+  void *addr = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, trace_fd, 0);
+  if (addr == MAP_FAILED)
+    return;
+
+  trace_map = (const gdb_byte *) addr;
+  trace_map_size = st.st_size;
+  trace_map_pos = lseek (trace_fd, 0, SEEK_CUR);
+#endif
+}
+
+/* Undo tfile_map_file.  */
+
+static void
+tfile_unmap_file ()
+{
+#ifdef HAVE_MMAP
+  if (trace_map != NULL)
+    munmap ((void *) trace_map, trace_map_size);
+#endif
+  trace_map = NULL;
+  trace_map_size = 0;
+  trace_map_pos = 0;
+}
+
+/* Forget the index of the traceframes.  */
+
+static void
+tfile_clear_frame_index ()
+{
+  trace_frames.clear ();
+  trace_frames.shrink_to_fit ();
+  trace_frames_by_tpnum.clear ();
+  trace_frames_indexed = false;
+  trace_frames_error.clear ();
+}
+
 /* Open the tfile target.  */
 
 static void
@@ -485,9 +601,11 @@ tfile_target_open (const char *arg, int from_tty)
 
   trace_filename = filename.release ();
   trace_fd = scratch_chan;
+  tfile_map_file ();
 
   /* Make sure this is clear.  */
   buffer_free (&trace_tdesc);
+  tfile_clear_frame_index ();
 
   bytes = 0;
   /* Read the file header and test for validity.  */
@@ -621,11 +739,13 @@ tfile_target::close ()
   inferior_ptid = null_ptid;	/* Avoid confusion from thread stuff.  */
   exit_inferior_silent (current_inferior ());
 
+  tfile_unmap_file ();
   ::close (trace_fd);
   trace_fd = -1;
   xfree (trace_filename);
   trace_filename = NULL;
   buffer_free (&trace_tdesc);
+  tfile_clear_frame_index ();
 
   trace_reset_local_state ();
 }
@@ -643,54 +763,89 @@ tfile_target::get_tracepoint_status (struct breakpoint *tp, struct uploaded_tp *
      trace files, so nothing to do here.  */
 }
 
-/* Given the position of a traceframe in the file, figure out what
-   address the frame was collected at.  This would normally be the
-   value of a collected PC register, but if not available, we
+/* Figure out what address a traceframe collected by the tracepoint
+   numbered TPNUM on the target was collected at.  This would normally
+   be the value of a collected PC register, but if not available, we
    improvise.  */
 
 static CORE_ADDR
-tfile_get_traceframe_address (off_t tframe_offset)
+tfile_get_traceframe_address (short tpnum)
 {
   CORE_ADDR addr = 0;
-  short tpnum;
   struct tracepoint *tp;
-  off_t saved_offset = cur_offset;
 
   /* FIXME dig pc out of collected registers.  */
 
   /* Fall back to using tracepoint address.  */
-  lseek (trace_fd, tframe_offset, SEEK_SET);
-  tfile_read ((gdb_byte *) &tpnum, 2);
-  tpnum = (short) extract_signed_integer ((gdb_byte *) &tpnum, 2,
-					  gdbarch_byte_order
-					      (target_gdbarch ()));
-
   tp = get_tracepoint_by_number_on_target (tpnum);
   /* FIXME this is a poor heuristic if multiple locations.  */
   if (tp && tp->loc)
     addr = tp->loc->address;
 
-  /* Restore our seek position.  */
-  cur_offset = saved_offset;
-  lseek (trace_fd, cur_offset, SEEK_SET);
   return addr;
 }
 
-/* Given a type of search and some parameters, scan the collection of
-   traceframes in the file looking for a match.  When found, return
-   both the traceframe and tracepoint number, otherwise -1 for
+/* Build the index of the traceframes in the file, if not done yet.
+   This reads just the header of each traceframe.  If the list of
+   traceframes is malformed, the traceframes before the problem are
+   still indexed, and the error is remembered in TRACE_FRAMES_ERROR.  */
+
+static void
+tfile_index_frames ()
+{
+  enum bfd_endian byte_order = gdbarch_byte_order (target_gdbarch ());
+  off_t offset;
+
+  if (trace_frames_indexed)
+    return;
+
+  trace_frames_indexed = true;
+  tfile_seek (trace_frames_offset, SEEK_SET);
+  offset = trace_frames_offset;
+  try
+    {
+      while (1)
+	{
+	  gdb_byte buf[4];
+	  tfile_frame_entry entry;
+
+	  tfile_read (buf, 2);
+	  entry.tpnum = (short) extract_signed_integer (buf, 2, byte_order);
+	  offset += 2;
+	  if (entry.tpnum == 0)
+	    break;
+	  tfile_read (buf, 4);
+	  entry.data_size
+	    = (unsigned int) extract_unsigned_integer (buf, 4, byte_order);
+	  offset += 4;
+	  entry.offset = offset;
+
+	  trace_frames_by_tpnum[entry.tpnum].push_back (trace_frames.size ());
+	  trace_frames.push_back (entry);
+
+	  /* Skip past the traceframe's data.  */
+	  tfile_seek (entry.data_size, SEEK_CUR);
+	  offset += entry.data_size;
+	}
+    }
+  catch (const gdb_exception_error &ex)
+    {
+      trace_frames_error = ex.what ();
+    }
+}
+
+/* Given a type of search and some parameters, find the matching
+   traceframe in the index of the file's traceframes.  When found,
+   return both the traceframe and tracepoint number, otherwise -1 for
    each.  */
 
 int
 tfile_target::trace_find (enum trace_find_type type, int num,
 			  CORE_ADDR addr1, CORE_ADDR addr2, int *tpp)
 {
-  short tpnum;
-  int tfnum = 0, found = 0;
-  unsigned int data_size;
   struct tracepoint *tp;
-  off_t offset, tframe_offset;
   CORE_ADDR tfaddr;
+  int tfnum = -1;
 
   if (num == -1)
     {
@@ -699,78 +854,74 @@ tfile_target::trace_find (enum trace_find_type type, int num,
       return -1;
     }
 
-  lseek (trace_fd, trace_frames_offset, SEEK_SET);
-  offset = trace_frames_offset;
-  while (1)
+  tfile_index_frames ();
+
+  if (type == tfind_number)
     {
-      tframe_offset = offset;
-      tfile_read ((gdb_byte *) &tpnum, 2);
-      tpnum = (short) extract_signed_integer ((gdb_byte *) &tpnum, 2,
-					      gdbarch_byte_order
-						  (target_gdbarch ()));
-      offset += 2;
-      if (tpnum == 0)
-	break;
-      tfile_read ((gdb_byte *) &data_size, 4);
-      data_size = (unsigned int) extract_unsigned_integer
-                                     ((gdb_byte *) &data_size, 4,
-				      gdbarch_byte_order (target_gdbarch ()));
-      offset += 4;
+      /* Looking for a specific trace frame.  */
+      if (num >= 0 && num < (int) trace_frames.size ())
+	tfnum = num;
+    }
+  else
+    {
+      /* Start from the _next_ trace frame.  For each tracepoint that
+	 matches, find its first traceframe after the current one,
+	 and take the earliest of those.  */
+      int cur = get_traceframe_number ();
 
-      if (type == tfind_number)
-	{
-	  /* Looking for a specific trace frame.  */
-	  if (tfnum == num)
-	    found = 1;
-	}
-      else
+      for (const auto &frames : trace_frames_by_tpnum)
 	{
-	  /* Start from the _next_ trace frame.  */
-	  if (tfnum > get_traceframe_number ())
+	  bool match;
+
+	  switch (type)
 	    {
-	      switch (type)
-		{
-		case tfind_pc:
-		  tfaddr = tfile_get_traceframe_address (tframe_offset);
-		  if (tfaddr == addr1)
-		    found = 1;
-		  break;
-		case tfind_tp:
-		  tp = get_tracepoint (num);
-		  if (tp && tpnum == tp->number_on_target)
-		    found = 1;
-		  break;
-		case tfind_range:
-		  tfaddr = tfile_get_traceframe_address (tframe_offset);
-		  if (addr1 <= tfaddr && tfaddr <= addr2)
-		    found = 1;
-		  break;
-		case tfind_outside:
-		  tfaddr = tfile_get_traceframe_address (tframe_offset);
-		  if (!(addr1 <= tfaddr && tfaddr <= addr2))
-		    found = 1;
-		  break;
-		default:
-		  internal_error (__FILE__, __LINE__, _("unknown tfind type"));
-		}
+	    case tfind_pc:
+	      tfaddr = tfile_get_traceframe_address (frames.first);
+	      match = tfaddr == addr1;
+	      break;
+	    case tfind_tp:
+	      tp = get_tracepoint (num);
+	      match = tp && frames.first == tp->number_on_target;
+	      break;
+	    case tfind_range:
+	      tfaddr = tfile_get_traceframe_address (frames.first);
+	      match = addr1 <= tfaddr && tfaddr <= addr2;
+	      break;
+	    case tfind_outside:
+	      tfaddr = tfile_get_traceframe_address (frames.first);
+	      match = !(addr1 <= tfaddr && tfaddr <= addr2);
+	      break;
+	    default:
+	      internal_error (__FILE__, __LINE__, _("unknown tfind type"));
 	    }
-	}
 
-      if (found)
-	{
-	  if (tpp)
-	    *tpp = tpnum;
-	  cur_offset = offset;
-	  cur_data_size = data_size;
+	  if (!match)
+	    continue;
 
-	  return tfnum;
+	  auto next = std::upper_bound (frames.second.begin (),
+					frames.second.end (), cur);
+	  if (next != frames.second.end () && (tfnum == -1 || *next < tfnum))
+	    tfnum = *next;
 	}
-      /* Skip past the traceframe's data.  */
-      lseek (trace_fd, data_size, SEEK_CUR);
-      offset += data_size;
-      /* Update our own count of traceframes.  */
-      ++tfnum;
     }
+
+  if (tfnum != -1)
+    {
+      const tfile_frame_entry &entry = trace_frames[tfnum];
+
+      if (tpp)
+	*tpp = entry.tpnum;
+      cur_offset = entry.offset;
+      cur_data_size = entry.data_size;
+
+      return tfnum;
+    }
+
+  /* A sequential scan of the file would have run into the same
+     problem as the indexing.  */
+  if (!trace_frames_error.empty ())
+    error ("%s", trace_frames_error.c_str ());
+
   /* Did not find what we were looking for.  */
   if (tpp)
     *tpp = -1;
@@ -808,7 +959,7 @@ traceframe_walk_blocks (walk_blocks_callback_func callback,
   /* Iterate through a traceframe's blocks, looking for a block of the
      requested type.  */
 
-  lseek (trace_fd, cur_offset + pos, SEEK_SET);
+  tfile_seek (cur_offset + pos, SEEK_SET);
   while (pos < cur_data_size)
     {
       unsigned short mlen;
@@ -824,21 +975,21 @@ traceframe_walk_blocks (walk_blocks_callback_func callback,
       switch (block_type)
 	{
 	case 'R':
-	  lseek (trace_fd, cur_offset + pos + trace_regblock_size, SEEK_SET);
+	  tfile_seek (cur_offset + pos + trace_regblock_size, SEEK_SET);
 	  pos += trace_regblock_size;
 	  break;
 	case 'M':
-	  lseek (trace_fd, cur_offset + pos + 8, SEEK_SET);
+	  tfile_seek (cur_offset + pos + 8, SEEK_SET);
 	  tfile_read ((gdb_byte *) &mlen, 2);
           mlen = (unsigned short)
                 extract_unsigned_integer ((gdb_byte *) &mlen, 2,
                                           gdbarch_byte_order
                                               (target_gdbarch ()));
-	  lseek (trace_fd, mlen, SEEK_CUR);
+	  tfile_seek (mlen, SEEK_CUR);
 	  pos += (8 + 2 + mlen);
 	  break;
 	case 'V':
-	  lseek (trace_fd, cur_offset + pos + 4 + 8, SEEK_SET);
+	  tfile_seek (cur_offset + pos + 4 + 8, SEEK_SET);
 	  pos += (4 + 8);
 	  break;
 	default:
@@ -986,7 +1137,7 @@ tfile_target::xfer_partial (enum target_object object,
 		amt = len;
 
 	      if (maddr != offset)
-	        lseek (trace_fd, offset - maddr, SEEK_CUR);
+	        tfile_seek (offset - maddr, SEEK_CUR);
 	      tfile_read (readbuf, amt);
 	      *xfered_len = amt;
 	      return TARGET_XFER_OK;
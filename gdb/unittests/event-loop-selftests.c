@@ -0,0 +1,213 @@
+/* Self tests for the event loop for GDB, the GNU debugger.
+
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "defs.h"
+
+#include "cli/cli-utils.h"
+#include "gdbcmd.h"
+#include "gdbsupport/event-loop.h"
+#include "gdbsupport/filestuff.h"
+#include "gdbsupport/scope-exit.h"
+#include "gdbsupport/selftest.h"
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+#include <chrono>
+#include <vector>
+
+namespace selftests {
+namespace event_loop_tests {
+
+/* Read ends of the pipes, and the number of times their handler was
+   called.  */
+static std::vector<int> read_fds;
+static std::vector<int> handler_calls;
+
+/* File handler for the read end of a pipe.  DATA is the pipe's index
+   in READ_FDS.  */
+
+static void
+pipe_handler (int err, gdb_client_data data)
+{
+  int idx = (int) (uintptr_t) data;
+  char c;
+
+  handler_calls[idx]++;
+  SELF_CHECK (err == 0);
+  SELF_CHECK (read (read_fds[idx], &c, 1) == 1);
+}
+
+/* Check that with NUM_PIPES file descriptors registered, an event on
+   any one of them is dispatched to the right handler, and only once.
+   Then dispatch NUM_EVENTS events spread over all the pipes.  */
+
+static void
+test_handlers (int num_pipes, int num_events)
+{
+  std::vector<int> write_fds;
+
+  read_fds.clear ();
+  handler_calls.assign (num_pipes, 0);
+
+  SCOPE_EXIT
+    {
+      for (int fd : read_fds)
+	{
+	  delete_file_handler (fd);
+	  close (fd);
+	}
+      for (int fd : write_fds)
+	close (fd);
+      read_fds.clear ();
+    };
+
+  for (int i = 0; i < num_pipes; i++)
+    {
+      int fds[2];
+
+      SELF_CHECK (gdb_pipe_cloexec (fds) == 0);
+      read_fds.push_back (fds[0]);
+      write_fds.push_back (fds[1]);
+      add_file_handler (fds[0], pipe_handler,
+			(gdb_client_data) (uintptr_t) i);
+    }
+
+  for (int target : { 0, num_pipes / 2, num_pipes - 1 })
+    {
+      std::vector<int> expected = handler_calls;
+      expected[target]++;
+
+      SELF_CHECK (write (write_fds[target], "x", 1) == 1);
+
+      /* Other event sources may be serviced first, so allow for a few
+	 iterations.  Each one returns promptly, since our pipe is
+	 ready.  */
+      for (int i = 0;
+	   i < 100 && handler_calls[target] != expected[target];
+	   i++)
+	gdb_do_one_event ();
+
+      SELF_CHECK (handler_calls == expected);
+    }
+
+  /* Visit the pipes in a scattered order, so that neither the event
+     loop's round-robin nor the order of registration helps.  */
+  std::vector<int> expected = handler_calls;
+  for (int i = 0; i < num_events; i++)
+    {
+      int target = (int) ((i * 7919L) % num_pipes);
+
+      expected[target]++;
+      SELF_CHECK (write (write_fds[target], "x", 1) == 1);
+      for (int j = 0;
+	   j < 100 && handler_calls[target] != expected[target];
+	   j++)
+	gdb_do_one_event ();
+    }
+  SELF_CHECK (handler_calls == expected);
+}
+
+static void
+test_many_handlers ()
+{
+  test_handlers (100, 1000);
+}
+
+} /* namespace event_loop_tests */
+} /* namespace selftests */
+
+/* The "maint event-loop-benchmark" command.  Like the "event-loop"
+   self test, but with thousands of file descriptors, which is where
+   the cost of waiting and dispatching shows.  */
+
+static void
+maintenance_event_loop_benchmark (const char *args, int from_tty)
+{
+  int num_pipes = 4000;
+  int num_events = 100000;
+
+  if (args != NULL && *args != '\0')
+    {
+      num_pipes = get_number (&args);
+      if (*args != '\0')
+	num_events = get_number (&args);
+      if (num_pipes <= 0 || num_events < 0 || *args != '\0')
+	error (_("Usage: maint event-loop-benchmark "
+		 "[NUM-PIPES [NUM-EVENTS]]"));
+    }
+
+#if defined (HAVE_GETRLIMIT) && defined (HAVE_SETRLIMIT) \
+    && defined (RLIMIT_NOFILE)
+  /* Each pipe takes two file descriptors, and GDB has a few open
+     already.  */
+  rlim_t needed = 2 * (rlim_t) num_pipes + 100;
+  struct rlimit old_rlim;
+  bool restore_rlim = false;
+
+  /* Raise the soft limit on open files if needed and allowed.  */
+  if (getrlimit (RLIMIT_NOFILE, &old_rlim) == 0
+      && old_rlim.rlim_cur != RLIM_INFINITY
+      && old_rlim.rlim_cur < needed)
+    {
+      struct rlimit rlim = old_rlim;
+
+      if (rlim.rlim_max != RLIM_INFINITY && rlim.rlim_max < needed)
+	error (_("Too many pipes; the limit on open files is %s."),
+	       pulongest (rlim.rlim_max));
+
+      rlim.rlim_cur = needed;
+      if (setrlimit (RLIMIT_NOFILE, &rlim) != 0)
+	perror_with_name (("setrlimit"));
+      restore_rlim = true;
+    }
+
+  SCOPE_EXIT
+    {
+      if (restore_rlim)
+	setrlimit (RLIMIT_NOFILE, &old_rlim);
+    };
+#endif
+
+  using namespace std::chrono;
+  steady_clock::time_point start = steady_clock::now ();
+
+  selftests::event_loop_tests::test_handlers (num_pipes, num_events);
+
+  duration<double> elapsed = steady_clock::now () - start;
+  printf_filtered (_("Dispatched %d events on %d pipes in %.3f seconds.\n"),
+		   num_events, num_pipes, elapsed.count ());
+}
+
+void _initialize_event_loop_selftests ();
+void
+_initialize_event_loop_selftests ()
+{
+  selftests::register_test ("event-loop",
+			    selftests::event_loop_tests::test_many_handlers);
+
+  add_cmd ("event-loop-benchmark", class_maintenance,
+	   maintenance_event_loop_benchmark, _("\
+Time the event loop with many file descriptors.\n\
+Usage: maint event-loop-benchmark [NUM-PIPES [NUM-EVENTS]]\n\
+Register a handler for each of NUM-PIPES pipes, 4000 by default, then\n\
+dispatch NUM-EVENTS events, 100000 by default, spread over the pipes,\n\
+and print how long that took."),
+	   &maintenancelist);
+}
@@ -3919,6 +3919,94 @@ value_fetch_lazy (struct value *val)
   set_value_lazy (val, 0);
 }
 
+/* See value.h.  */
+
+void
+value_fetch_lazy_batch (gdb::array_view<value *> vals)
+{
+  struct candidate
+  {
+    struct value *val;
+    CORE_ADDR addr;
+    ULONGEST length;
+    int stack;
+  };
+  std::vector<candidate> cands;
+
+  for (value *val : vals)
+    {
+      if (val == NULL
+	  || !value_lazy (val)
+	  || VALUE_LVAL (val) != lval_memory
+	  || value_bitsize (val) != 0
+	  || gdbarch_addressable_memory_unit_size (get_value_arch (val)) != 1)
+	continue;
+
+      struct type *type = check_typedef (value_enclosing_type (val));
+      if (TYPE_LENGTH (type) == 0)
+	continue;
+
+      cands.push_back ({ val, value_address (val), TYPE_LENGTH (type),
+			 value_stack (val) });
+    }
+
+  if (cands.size () < 2)
+    return;
+
+  std::sort (cands.begin (), cands.end (),
+	     [] (const candidate &a, const candidate &b)
+	     {
+	       if (a.stack != b.stack)
+		 return a.stack < b.stack;
+	       return a.addr < b.addr;
+	     });
+
+  /* Only merge values that touch or overlap, so that we read exactly
+     the bytes that fetching the values one by one would.  */
+  gdb::byte_vector buf;
+  for (size_t first = 0, last; first < cands.size (); first = last)
+    {
+      CORE_ADDR start = cands[first].addr;
+      CORE_ADDR end = start + cands[first].length;
+
+      for (last = first + 1; last < cands.size (); ++last)
+	{
+	  if (cands[last].stack != cands[first].stack
+	      || cands[last].addr > end)
+	    break;
+	  end = std::max (end, cands[last].addr + cands[last].length);
+	}
+
+      if (last - first < 2)
+	continue;
+
+      buf.resize (end - start);
+      int status = (cands[first].stack
+		    ? target_read_stack (start, buf.data (), end - start)
+		    : target_read_memory (start, buf.data (), end - start));
+
+      /* On failure, leave the values lazy; value_fetch_lazy will find
+	 out which of them are unavailable or unreadable, and report it
+	 when they are used.  */
+      if (status != 0)
+	continue;
+
+      for (size_t i = first; i < last; ++i)
+	{
+	  struct value *val = cands[i].val;
+
+	  /* The same value may be listed more than once.  */
+	  if (!value_lazy (val))
+	    continue;
+
+	  allocate_value_contents (val);
+	  memcpy (value_contents_all_raw (val),
+		  buf.data () + (cands[i].addr - start), cands[i].length);
+	  set_value_lazy (val, 0);
+	}
+    }
+}
+
 /* Implementation of the convenience function $_isvoid.  */
 
 static struct value *
@@ -397,6 +397,18 @@ extern const gdb_byte *
 
 extern void value_fetch_lazy (struct value *val);
 
+/* Fetch the contents of the lazy values in VALS, reading the memory
+   of values that are adjacent or overlap in the inferior with a single
+   target access.  This is much cheaper than fetching each value in
+   turn when there are many small values, e.g. the elements of a
+   container being pretty-printed, particularly with remote targets.
+
+   Values that are not lazy memory values, and values whose memory
+   can't be read, are left untouched; value_fetch_lazy will handle
+   them (and report any error) when they are needed.  */
+
+extern void value_fetch_lazy_batch (gdb::array_view<value *> vals);
+
 /* If nonzero, this is the value of a variable which does not actually
    exist in the program, at least partially.  If the value is lazy,
    this may fetch it now.  */
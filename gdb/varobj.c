@@ -31,6 +31,7 @@
 #include "varobj-iter.h"
 #include "parser-defs.h"
 #include "gdbarch.h"
+#include "observable.h"
 
 #if HAVE_PYTHON
 #include "python/python.h"
@@ -62,6 +63,23 @@ varobj_enable_pretty_printing (void)
   pretty_printing = true;
 }
 
+/* A counter bumped whenever something that the values of variable
+   objects depend on may have changed: the inferior ran, memory or
+   registers were written, symbols were loaded or unloaded, etc.  A
+   root whose expression was last evaluated in the current generation
+   can't have changed, and neither can its children, so -var-update
+   can skip it without reading anything from the target.  Use
+   varobj_current_generation to read it.  */
+static unsigned int varobj_generation = 1;
+
+/* The value of target_write_generation when varobj_generation was
+   last brought up to date with it.  */
+static unsigned int varobj_target_write_generation;
+
+/* Like varobj_generation, but only bumped when a setting changes,
+   which may change the way values are printed.  */
+static unsigned int varobj_print_generation = 1;
+
 /* Data structures */
 
 /* Every root variable has one of these structures saved in its
@@ -101,6 +119,11 @@ struct varobj_root
   /* The varobj for this root node.  */
   struct varobj *rootvar = NULL;
 
+  /* The value of varobj_generation when this root was last
+     evaluated, or 0 if it must be evaluated again by the next
+     update.  */
+  unsigned int generation = 0;
+
   /* Next root variable */
   struct varobj_root *next = NULL;
 };
@@ -172,6 +195,10 @@ static bool update_type_if_necessary (struct varobj *var,
 static bool install_new_value (struct varobj *var, struct value *value,
 			       bool initial);
 
+static void varobj_invalidate_generation (struct varobj *var);
+
+static unsigned int varobj_evaluation_generation ();
+
 /* Language-specific routines.  */
 
 static int number_of_children (const struct varobj *);
@@ -363,6 +390,7 @@ varobj_create (const char *objname,
       /* We definitely need to catch errors here.
          If evaluate_expression succeeds we got the value we wanted.
          But if it fails, we still go on with a call to evaluate_type().  */
+      var->root->generation = varobj_evaluation_generation ();
       try
 	{
 	  value = evaluate_expression (var->root->exp.get ());
@@ -519,6 +547,9 @@ varobj_set_display_format (struct varobj *var,
       var->format = variable_default_display (var);
     }
 
+  varobj_invalidate_generation (var);
+  var->print_generation = 0;
+
   if (varobj_value_is_changeable_p (var) 
       && var->value != nullptr && !value_lazy (var->value.get ()))
     {
@@ -589,6 +620,7 @@ varobj_set_frozen (struct varobj *var, bool frozen)
      should do -var-update anyway.  It would be bad to have different
      client-size logic for structure and other types.  */
   var->frozen = frozen;
+  varobj_invalidate_generation (var);
 }
 
 bool
@@ -839,6 +871,7 @@ const std::vector<varobj *> &
 varobj_list_children (struct varobj *var, int *from, int *to)
 {
   var->dynamic->children_requested = true;
+  varobj_invalidate_generation (var);
 
   if (varobj_is_dynamic_p (var))
     {
@@ -1230,6 +1263,169 @@ update_type_if_necessary (struct varobj *var, struct value *new_value)
   return false;
 }
 
+/* Make the next update of VAR's root evaluate it again, because a
+   property of VAR that matters to the update changed.  */
+
+static void
+varobj_invalidate_generation (struct varobj *var)
+{
+  var->root->generation = 0;
+}
+
+/* Return the current generation, starting a new one first if
+   anything was written to a target since the last call.  Not every
+   write notifies an observer -- "restore", -data-write-register-values
+   and popping a frame with "return" don't -- so writes are noticed at
+   the target layer, whatever path they take.  */
+
+static unsigned int
+varobj_current_generation ()
+{
+  unsigned int writes = target_write_generation ();
+
+  if (writes != varobj_target_write_generation)
+    {
+      varobj_target_write_generation = writes;
+      ++varobj_generation;
+    }
+
+  return varobj_generation;
+}
+
+/* Return the generation that a root evaluated now belongs to: the
+   current one, unless some thread is running, in which case memory may
+   change at any time, and the root must be evaluated again by the next
+   update.  */
+
+static unsigned int
+varobj_evaluation_generation ()
+{
+  for (thread_info *tp : all_non_exited_threads ())
+    if (tp->state == THREAD_RUNNING)
+      return 0;
+
+  return varobj_current_generation ();
+}
+
+/* Return true if the value of the expression EXP may change even
+   though the inferior did not run and nothing was written to it,
+   because it refers to a convenience variable or to the value
+   history, or calls a function.  */
+
+static bool
+varobj_exp_is_volatile (const struct expression *exp)
+{
+  for (int endpos = exp->nelts; endpos > 0; )
+    {
+      int oplen = 0, args;
+
+      operator_length (exp, endpos, &oplen, &args);
+      gdb_assert (oplen > 0);
+      endpos -= oplen;
+
+      switch (exp->elts[endpos].opcode)
+	{
+	case OP_INTERNALVAR:
+	case OP_LAST:
+	case OP_FUNCALL:
+	case OP_F77_UNDETERMINED_ARGLIST:
+	case OP_OBJC_MSGCALL:
+	  return true;
+
+	default:
+	  break;
+	}
+    }
+
+  return false;
+}
+
+/* Return true if neither ROOT nor any of its children can have
+   changed since ROOT was last evaluated.  */
+
+static bool
+varobj_root_is_current (const struct varobj_root *root)
+{
+  return (root->generation == varobj_current_generation ()
+	  && !root->floating
+	  && !varobj_exp_is_volatile (root->exp.get ()));
+}
+
+/* Return true if the children of VAR that -var-update visits are at
+   least as large as VAR's value together.  Only then is it worth
+   reading VAR's value in one go, instead of letting each child read
+   its own part: a large array of which only a few elements have
+   varobjs, or whose other children are frozen, would otherwise be read
+   in full by every update.  */
+
+static bool
+varobj_children_cover_value (const struct varobj *var)
+{
+  ULONGEST size = TYPE_LENGTH (check_typedef (value_type (var->value.get ())));
+  ULONGEST covered = 0;
+
+  for (const varobj *child : var->children)
+    if (child != NULL && !child->frozen && child->value != nullptr)
+      {
+	struct type *type = check_typedef (value_type (child->value.get ()));
+
+	covered += TYPE_LENGTH (type);
+	if (covered >= size)
+	  return true;
+      }
+
+  return false;
+}
+
+/* Return true if NEW_VALUE, the new value of VAR, would be printed
+   exactly like VAR's current value, whose printed form is in VAR's
+   print_value.  That is the case if the contents of the two values
+   are the same, and the printed form of their type depends only on
+   the contents -- unlike, e.g., a pointer to characters, which is
+   printed with the string it points to.  */
+
+static bool
+varobj_print_value_unchanged (const struct varobj *var,
+			      struct value *new_value)
+{
+  struct value *old_value = var->value.get ();
+
+  if (old_value == NULL
+      || value_lazy (old_value)
+      || var->print_value.empty ()
+      || var->print_generation != varobj_print_generation
+      || value_type (old_value) != value_type (new_value))
+    return false;
+
+  struct type *type = check_typedef (value_type (new_value));
+  switch (type->code ())
+    {
+    case TYPE_CODE_INT:
+    case TYPE_CODE_CHAR:
+    case TYPE_CODE_BOOL:
+    case TYPE_CODE_ENUM:
+    case TYPE_CODE_FLT:
+      break;
+
+    case TYPE_CODE_PTR:
+      {
+	struct type *target = check_typedef (TYPE_TARGET_TYPE (type));
+
+	if (target->code () == TYPE_CODE_INT
+	    || target->code () == TYPE_CODE_CHAR)
+	  return false;
+      }
+      break;
+
+    default:
+      return false;
+    }
+
+  return value_contents_eq (old_value, value_embedded_offset (old_value),
+			    new_value, value_embedded_offset (new_value),
+			    TYPE_LENGTH (type));
+}
+
 /* Assign a new value to a variable object.  If INITIAL is true,
    this is the first assignment after the variable object was just
    created, or changed type.  In that case, just assign the value 
@@ -1334,7 +1530,14 @@ install_new_value (struct varobj *var, struct value *value, bool initial)
   std::string print_value;
   if (value != NULL && !value_lazy (value)
       && var->dynamic->pretty_printer == NULL)
-    print_value = varobj_value_get_print_value (value, var->format, var);
+    {
+      /* Formatting a value is costly, so don't do it again if the
+	 result is known in advance.  */
+      if (!initial && varobj_print_value_unchanged (var, value))
+	print_value = var->print_value;
+      else
+	print_value = varobj_value_get_print_value (value, var->format, var);
+    }
 
   /* If the type is changeable, compare the old and the new values.
      If this is the initial assignment, we don't have any old value
@@ -1412,6 +1615,7 @@ install_new_value (struct varobj *var, struct value *value, bool initial)
 	  changed = true;
     }
   var->print_value = print_value;
+  var->print_generation = varobj_print_generation;
 
   gdb_assert (var->value == nullptr || value_type (var->value.get ()));
 
@@ -1437,6 +1641,7 @@ varobj_set_child_range (struct varobj *var, int from, int to)
 {
   var->from = from;
   var->to = to;
+  varobj_invalidate_generation (var);
 }
 
 void 
@@ -1467,6 +1672,7 @@ varobj_set_visualizer (struct varobj *var, const char *visualizer)
   /* If there are any children now, wipe them.  */
   varobj_delete (var, 1 /* children only */);
   var->num_children = -1;
+  varobj_invalidate_generation (var);
 #else
   error (_("Python support required"));
 #endif
@@ -1546,12 +1752,20 @@ varobj_update (struct varobj **varp, bool is_explicit)
     {
       varobj_update_result r (*varp);
 
+      if (varobj_root_is_current ((*varp)->root))
+	return result;
+
+      /* Note the generation before evaluating the root, which may
+	 itself write to the inferior.  */
+      unsigned int generation = varobj_evaluation_generation ();
+
       /* Update the root variable.  value_of_root can return NULL
 	 if the variable is no longer around, i.e. we stepped out of
 	 the frame in which a local existed.  We are letting the 
 	 value_of_root variable dispose of the varobj if the type
 	 has changed.  */
       newobj = value_of_root (varp, &type_changed);
+      (*varp)->root->generation = generation;
       if (update_type_if_necessary (*varp, newobj))
 	  type_changed = true;
       r.varobj = *varp;
@@ -1704,6 +1918,25 @@ varobj_update (struct varobj **varp, bool is_explicit)
 	    }
 	}
 
+      /* The values of the children are extracted from V's value.  If
+	 it is lazy, as is usual for structures and arrays, each child
+	 would read its own bit of memory; read all of it at once
+	 instead, unless that would read much more than the children
+	 need.  If that fails, leave it to each child to find out which
+	 part can't be read.  */
+      if (!v->children.empty () && !v->frozen
+	  && v->value != nullptr && value_lazy (v->value.get ())
+	  && varobj_children_cover_value (v))
+	{
+	  try
+	    {
+	      value_fetch_lazy (v->value.get ());
+	    }
+	  catch (const gdb_exception_error &except)
+	    {
+	    }
+	}
+
       /* Push any children.  Use reverse order so that the first
 	 child is popped from the work stack first, and so
 	 will be added to result first.  This does not
@@ -2533,4 +2766,34 @@ _initialize_varobj ()
 			     _("When non-zero, varobj debugging is enabled."),
 			     NULL, show_varobjdebug,
 			     &setdebuglist, &showdebuglist);
+
+  /* Anything that may change the values of variable objects, or the
+     way they are printed, starts a new generation.  Writes to the
+     inferior are caught by varobj_current_generation.  */
+  gdb::observers::target_resumed.attach
+    ([] (ptid_t ptid) { ++varobj_generation; });
+  gdb::observers::traceframe_changed.attach
+    ([] (int tfnum, int tpnum) { ++varobj_generation; });
+  gdb::observers::inferior_exit.attach
+    ([] (struct inferior *inf) { ++varobj_generation; });
+  gdb::observers::target_changed.attach
+    ([] (struct target_ops *target) { ++varobj_generation; });
+  gdb::observers::new_objfile.attach
+    ([] (struct objfile *objfile)
+     {
+       ++varobj_generation;
+       ++varobj_print_generation;
+     });
+  gdb::observers::free_objfile.attach
+    ([] (struct objfile *objfile)
+     {
+       ++varobj_generation;
+       ++varobj_print_generation;
+     });
+  gdb::observers::command_param_changed.attach
+    ([] (const char *param, const char *value)
+     {
+       ++varobj_generation;
+       ++varobj_print_generation;
+     });
 }
@@ -146,6 +146,10 @@ struct varobj
   /* Last print value.  */
   std::string print_value;
 
+  /* The value of varobj_print_generation when PRINT_VALUE was
+     computed.  */
+  unsigned int print_generation = 0;
+
   /* Is this variable frozen.  Frozen variables are never implicitly
      updated by -var-update * 
      or -var-update <direct-or-indirect-parent>.  */
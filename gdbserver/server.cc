@@ -2119,6 +2119,86 @@ crc32 (CORE_ADDR base, int len, unsigned int crc)
   return (unsigned long long) crc;
 }
 
+/* Handle qThreadRegisters:PTID[;PTID]...  Reply with
+   "PTID:SIZE:REGS" for each listed thread, REGS being the SIZE bytes
+   of the 'g' packet contents in escaped binary.  Threads we don't know
+   about, or with unavailable registers, are left out, and we stop
+   early if the next entry would not fit in the packet buffer.  Set
+   *NEW_PACKET_LEN_P to the length of the reply.  */
+
+static void
+handle_thread_registers (char *own_buf, int *new_packet_len_p)
+{
+  client_state &cs = get_client_state ();
+
+  if (cs.current_traceframe >= 0)
+    {
+      write_enn (own_buf);
+      return;
+    }
+
+  /* The reply overwrites the request, so parse from a copy.  */
+  std::string request (own_buf + strlen ("qThreadRegisters:"));
+  const char *p = request.c_str ();
+  char *out = own_buf;
+  char *out_end = own_buf + PBUFSIZ;
+
+  while (*p != '\0')
+    {
+      ptid_t ptid = read_ptid (p, &p);
+
+      if (*p == ';')
+	p++;
+      else if (*p != '\0')
+	{
+	  write_enn (own_buf);
+	  return;
+	}
+
+      thread_info *thread = find_thread_ptid (ptid);
+      if (thread == NULL)
+	continue;
+
+      struct regcache *regcache = get_thread_regcache (thread, 1);
+      const target_desc *tdesc = regcache->tdesc;
+
+      /* Binary data can't mark a register as unavailable the way the
+	 'g' reply does; GDB reads such threads with 'g' instead.  */
+      bool all_valid = true;
+      for (int i = 0; i < tdesc->reg_defs.size (); i++)
+	if (regcache->register_status[i] != REG_VALID)
+	  {
+	    all_valid = false;
+	    break;
+	  }
+      if (!all_valid)
+	continue;
+
+      char header[120];
+      char *h = write_ptid (header, ptid);
+      h += sprintf (h, ":%x:", tdesc->registers_size);
+      int header_len = h - header;
+      if (out_end - out <= header_len)
+	break;
+
+      int out_len_units;
+      int escaped_len
+	= remote_escape_output (regcache->registers, tdesc->registers_size,
+				1, (gdb_byte *) out + header_len,
+				&out_len_units, out_end - out - header_len);
+      if (out_len_units < tdesc->registers_size)
+	break;
+
+      memcpy (out, header, header_len);
+      out += header_len + escaped_len;
+    }
+
+  if (out == own_buf)
+    write_enn (own_buf);
+  else
+    *new_packet_len_p = out - own_buf;
+}
+
 /* Add supported btrace packets to BUF.  */
 
 static void
@@ -2467,6 +2547,10 @@ handle_query (char *own_buf, int packet_len, int *new_packet_len_p)
 
       strcat (own_buf, ";no-resumed+");
 
+      strcat (own_buf, ";qThreadRegisters+");
+
+      strcat (own_buf, ";binary-upload+");
+
       /* Reinitialize components as needed for the new connection.  */
       hostio_handle_new_gdb_connection ();
       target_handle_new_gdb_connection ();
@@ -2562,6 +2646,13 @@ handle_query (char *own_buf, int packet_len, int *new_packet_len_p)
       return;
     }
 
+  if (startswith (own_buf, "qThreadRegisters:"))
+    {
+      require_running_or_return (own_buf);
+      handle_thread_registers (own_buf, new_packet_len_p);
+      return;
+    }
+
   /* Handle "monitor" commands.  */
   if (startswith (own_buf, "qRcmd,"))
     {
@@ -4190,6 +4281,29 @@ process_serial_event (void)
 	  bin2hex (mem_buf, cs.own_buf, res);
       }
       break;
+    case 'x':
+      {
+	require_running_or_break (cs.own_buf);
+	decode_m_packet (&cs.own_buf[1], &mem_addr, &len);
+	if (len > PBUFSIZ)
+	  len = PBUFSIZ;
+	int res = gdb_read_memory (mem_addr, mem_buf, len);
+	if (res < 0)
+	  write_enn (cs.own_buf);
+	else
+	  {
+	    int out_len_units;
+
+	    /* Send as much as fits in a packet after escaping; GDB
+	       handles short reads.  */
+	    cs.own_buf[0] = 'b';
+	    new_packet_len
+	      = 1 + remote_escape_output (mem_buf, res, 1,
+					  (gdb_byte *) cs.own_buf + 1,
+					  &out_len_units, PBUFSIZ - 2);
+	  }
+      }
+      break;
     case 'M':
       require_running_or_break (cs.own_buf);
       decode_M_packet (&cs.own_buf[1], &mem_addr, &len, &mem_buf);
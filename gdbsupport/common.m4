@@ -47,11 +47,12 @@ AC_DEFUN([GDB_AC_COMMON], [
 		   termios.h dnl
 		   dlfcn.h dnl
 		   linux/elf.h sys/procfs.h proc_service.h dnl
-		   poll.h sys/poll.h sys/select.h)
+		   poll.h sys/poll.h sys/select.h sys/epoll.h)
 
   AC_FUNC_MMAP
   AC_FUNC_VFORK
-  AC_CHECK_FUNCS([fdwalk getrlimit pipe pipe2 poll socketpair sigaction \
+  AC_CHECK_FUNCS([fdwalk getrlimit pipe pipe2 poll epoll_create1 \
+		  socketpair sigaction \
 		  ptrace64 sbrk setns sigaltstack sigprocmask \
 		  setpgid setpgrp getrusage getauxval])
 
@@ -30,6 +30,10 @@
 #endif
 #endif
 
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#endif
+
 #include <sys/types.h>
 #include "gdbsupport/gdb_sys_time.h"
 #include "gdbsupport/gdb_select.h"
@@ -66,6 +70,28 @@ file_handler;
 
 static unsigned char use_poll = USE_POLL;
 
+/* Do we use epoll to wait for the file descriptors of the poll
+   variant?  epoll only replaces the waiting: POLL_FDS is kept up to
+   date as well, so that we can fall back to plain poll at any time,
+   e.g. when a file descriptor that epoll refuses to monitor (like a
+   regular file) is registered.  With epoll, the cost of waiting for
+   and dispatching an event no longer grows with the number of
+   registered file descriptors.  */
+#if defined (HAVE_POLL) && defined (HAVE_SYS_EPOLL_H) \
+  && defined (HAVE_EPOLL_CREATE1)
+#define USE_EPOLL 1
+#else
+#define USE_EPOLL 0
+#endif
+
+static unsigned char use_epoll = USE_EPOLL;
+
+#if USE_EPOLL
+/* The epoll instance, created along with the first file handler, or
+   -1.  */
+static int epoll_fd = -1;
+#endif
+
 #ifdef USE_WIN32API
 #include <windows.h>
 #include <io.h>
@@ -150,6 +176,9 @@ timer_list;
 
 static void create_file_handler (int fd, int mask, handler_func *proc,
 				 gdb_client_data client_data);
+#if USE_EPOLL
+static void epoll_add_file_handler (file_handler *file_ptr);
+#endif
 static int gdb_wait_for_event (int);
 static int update_wait_timeout (void);
 static int poll_timers (void);
@@ -347,8 +376,72 @@ create_file_handler (int fd, int mask, handler_func * proc,
   file_ptr->proc = proc;
   file_ptr->client_data = client_data;
   file_ptr->mask = mask;
+
+#if USE_EPOLL
+  if (use_poll && use_epoll)
+    epoll_add_file_handler (file_ptr);
+#endif
+}
+
+#if USE_EPOLL
+
+/* Stop using epoll, and wait with plain poll from now on.  */
+
+static void
+disable_epoll (void)
+{
+  if (epoll_fd >= 0)
+    close (epoll_fd);
+  epoll_fd = -1;
+  use_epoll = 0;
+}
+
+/* Register FILE_PTR's file descriptor and poll mask with the epoll
+   instance, creating it if needed.  If FILE_PTR was already
+   registered, just update its mask.
+
+   epoll is used level-triggered, like poll: we handle a single event
+   per wait, and rely on the events not handled yet to be reported
+   again by the next wait.  The event data points directly to
+   FILE_PTR, so that dispatching an event does not need to look up
+   the handler.  */
+
+static void
+epoll_add_file_handler (file_handler *file_ptr)
+{
+  struct epoll_event event;
+
+  if (epoll_fd < 0)
+    {
+      epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+      if (epoll_fd < 0)
+	{
+	  disable_epoll ();
+	  return;
+	}
+    }
+
+  memset (&event, 0, sizeof (event));
+  if (file_ptr->mask & POLLIN)
+    event.events |= EPOLLIN;
+  if (file_ptr->mask & POLLPRI)
+    event.events |= EPOLLPRI;
+  if (file_ptr->mask & POLLOUT)
+    event.events |= EPOLLOUT;
+  event.data.ptr = file_ptr;
+
+  if (epoll_ctl (epoll_fd, EPOLL_CTL_ADD, file_ptr->fd, &event) != 0
+      && (errno != EEXIST
+	  || epoll_ctl (epoll_fd, EPOLL_CTL_MOD, file_ptr->fd, &event) != 0))
+    {
+      /* For instance, epoll refuses regular files, which poll always
+	 reports as ready.  */
+      disable_epoll ();
+    }
 }
 
+#endif /* USE_EPOLL */
+
 /* Return the next file handler to handle, and advance to the next
    file handler, wrapping around if the end of the list is
    reached.  */
@@ -421,6 +514,16 @@ delete_file_handler (int fd)
       xfree (gdb_notifier.poll_fds);
       gdb_notifier.poll_fds = new_poll_fds;
       gdb_notifier.num_fds--;
+
+#if USE_EPOLL
+      /* If FD has already been closed, we can't tell whether the kernel
+	 has forgotten about it, or whether another copy of it keeps it
+	 in the epoll set, where its events would still point to
+	 FILE_PTR.  Fall back to poll in that case.  */
+      if (epoll_fd >= 0
+	  && epoll_ctl (epoll_fd, EPOLL_CTL_DEL, fd, NULL) != 0)
+	disable_epoll ();
+#endif
 #else
       internal_error (__FILE__, __LINE__,
 		      _("use_poll without HAVE_POLL"));
@@ -562,6 +665,10 @@ gdb_wait_for_event (int block)
 {
   file_handler *file_ptr;
   int num_found = 0;
+#if USE_EPOLL
+  struct epoll_event epoll_event;
+  bool waited_with_epoll = false;
+#endif
 
   /* Make sure all output is done before getting another event.  */
   flush_streams ();
@@ -582,13 +689,28 @@ gdb_wait_for_event (int block)
       else
 	timeout = 0;
 
-      num_found = poll (gdb_notifier.poll_fds,
-			(unsigned long) gdb_notifier.num_fds, timeout);
+#if USE_EPOLL
+      if (use_epoll && epoll_fd >= 0)
+	{
+	  waited_with_epoll = true;
+	  num_found = epoll_wait (epoll_fd, &epoll_event, 1, timeout);
+
+	  /* Don't print anything if we get out of epoll_wait because
+	     of a signal.  */
+	  if (num_found == -1 && errno != EINTR)
+	    perror_with_name (("epoll_wait"));
+	}
+      else
+#endif
+	{
+	  num_found = poll (gdb_notifier.poll_fds,
+			    (unsigned long) gdb_notifier.num_fds, timeout);
 
-      /* Don't print anything if we get out of poll because of a
-	 signal.  */
-      if (num_found == -1 && errno != EINTR)
-	perror_with_name (("poll"));
+	  /* Don't print anything if we get out of poll because of a
+	     signal.  */
+	  if (num_found == -1 && errno != EINTR)
+	    perror_with_name (("poll"));
+	}
 #else
       internal_error (__FILE__, __LINE__,
 		      _("use_poll without HAVE_POLL"));
@@ -649,6 +771,30 @@ gdb_wait_for_event (int block)
       int i;
       int mask;
 
+#if USE_EPOLL
+      if (waited_with_epoll)
+	{
+	  /* epoll_wait returns at most one event, and itself rotates
+	     through the ready file descriptors.  */
+	  file_ptr = (file_handler *) epoll_event.data.ptr;
+
+	  mask = 0;
+	  if (epoll_event.events & EPOLLIN)
+	    mask |= POLLIN;
+	  if (epoll_event.events & EPOLLPRI)
+	    mask |= POLLPRI;
+	  if (epoll_event.events & EPOLLOUT)
+	    mask |= POLLOUT;
+	  if (epoll_event.events & EPOLLERR)
+	    mask |= POLLERR;
+	  if (epoll_event.events & EPOLLHUP)
+	    mask |= POLLHUP;
+
+	  handle_file_event (file_ptr, mask);
+	  return 1;
+	}
+#endif
+
       while (1)
 	{
 	  if (gdb_notifier.next_poll_fds_index >= gdb_notifier.num_fds)
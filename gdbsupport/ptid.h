@@ -32,6 +32,8 @@
    thread_stratum target that might want to sit on top.
 */
 
+#include <functional>
+
 class ptid_t
 {
 public:
@@ -152,4 +154,19 @@ extern const ptid_t null_ptid;
 
 extern const ptid_t minus_one_ptid;
 
+/* Functor to hash a ptid_t, for use as the hash function of
+   std::unordered_map and friends.  */
+
+struct hash_ptid
+{
+  size_t operator() (const ptid_t &ptid) const
+  {
+    std::hash<long> long_hash;
+
+    return (long_hash (ptid.pid ())
+	    + long_hash (ptid.lwp ())
+	    + long_hash (ptid.tid ()));
+  }
+};
+
 #endif /* COMMON_PTID_H */
@@ -354,6 +354,9 @@ struct bfd_link_info
   /* TRUE if exported symbols should be kept during section gc.  */
   unsigned int gc_keep_exported: 1;
 
+  /* TRUE if identical code sections should be folded.  */
+  unsigned int icf: 1;
+
   /* TRUE if every symbol should be reported back via the notice
      callback.  */
   unsigned int notice_all: 1;
@@ -490,6 +493,9 @@ struct bfd_link_info
   /* TRUE if user should be informed of removed unreferenced sections.  */
   unsigned int print_gc_sections: 1;
 
+  /* TRUE if user should be informed of folded sections.  */
+  unsigned int print_icf_sections: 1;
+
   /* TRUE if we should warn alternate ELF machine code.  */
   unsigned int warn_alternate_em: 1;
 
@@ -300,6 +300,10 @@ typedef struct
 
   /* If set, print discarded sections in map file output.  */
   bfd_boolean print_map_discarded;
+
+  /* If set, map the contents of input sections from the input files
+     where possible, rather than reading copies.  */
+  bfd_boolean mmap_inputs;
 } ld_config_type;
 
 extern ld_config_type config;
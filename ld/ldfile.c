@@ -145,6 +145,9 @@ ldfile_try_open_bfd (const char *attempt,
   /* Linker needs to decompress sections.  */
   entry->the_bfd->flags |= BFD_DECOMPRESS;
 
+  if (config.mmap_inputs)
+    entry->the_bfd->flags |= BFD_MMAP_CONTENTS;
+
   /* This is a linker input BFD.  */
   entry->the_bfd->is_linker_input = 1;
 
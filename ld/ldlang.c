@@ -784,6 +784,397 @@ walk_wild_section_specs4_wild2 (lang_wild_statement_type *ptr,
     }
 }
 
+/* An index of the section wildcards of the wild statements of the
+   script, so that each input section can be matched against all of
+   them in one go.  Every spec goes into a trie under the literal
+   prefix of its pattern.  Looking up a section name then only has to
+   check the specs found along the name's path through the trie.  The
+   matches of each input file are found up front, in parallel with
+   --threads, and walk_wild_section then just replays those of a wild
+   statement in the order walk_wild_section_general would make them.  */
+
+enum wild_index_kind
+{
+  /* A pattern without wildcards, matching just one name.  */
+  wild_index_literal,
+  /* A literal prefix followed by a single '*'.  */
+  wild_index_prefix,
+  /* Anything else, to be checked with fnmatch.  */
+  wild_index_glob,
+  /* No pattern, matching every name.  */
+  wild_index_all
+};
+
+struct wild_index_spec
+{
+  struct wildcard_list *sec;
+  /* The wild_index of the statement SEC belongs to.  */
+  unsigned int stmt;
+  enum wild_index_kind kind;
+};
+
+struct wild_index_node
+{
+  struct wild_index_node *child;
+  struct wild_index_node *sibling;
+  /* Indices into wild_index.specs of the specs whose literal prefix
+     ends here.  */
+  size_t *specs;
+  size_t spec_count;
+  char c;
+};
+
+/* A section matching a spec, found by wild_index_file_matches.  */
+
+struct wild_index_match
+{
+  asection *section;
+  struct wildcard_list *sec;
+  unsigned int stmt;
+  /* The position of the match among those of the file, which orders
+     the matches of a statement by section and then by spec.  */
+  size_t seq;
+};
+
+struct wild_index_file
+{
+  /* The number of sections the file had when it was indexed.  */
+  unsigned int section_count;
+  size_t count;
+  struct wild_index_match *matches;
+};
+
+static struct
+{
+  struct wild_index_spec *specs;
+  size_t spec_count;
+  size_t spec_alloc;
+  unsigned int stmt_count;
+  struct wild_index_node root;
+  lang_input_statement_type **files;
+} wild_index;
+
+/* With --threads, the number of input files per thread needed before
+   matching is spread over several threads.  */
+#define WILD_INDEX_FILES_PER_THREAD 16
+
+/* Add the spec SEC of the wild statement numbered STMT to the index.  */
+
+static void
+wild_index_add_spec (struct wildcard_list *sec, unsigned int stmt)
+{
+  struct wild_index_node *node = &wild_index.root;
+  struct wild_index_spec *spec;
+  const char *name = sec->spec.name;
+  size_t len = 0;
+  size_t i;
+
+  if (wild_index.spec_count == wild_index.spec_alloc)
+    {
+      wild_index.spec_alloc = wild_index.spec_alloc * 2 + 64;
+      wild_index.specs = (struct wild_index_spec *)
+	xrealloc (wild_index.specs,
+		  wild_index.spec_alloc * sizeof (*wild_index.specs));
+    }
+  spec = &wild_index.specs[wild_index.spec_count];
+  spec->sec = sec;
+  spec->stmt = stmt;
+
+  if (name == NULL)
+    spec->kind = wild_index_all;
+  else if (!wildcardp (name))
+    {
+      /* Match the terminating NUL too.  */
+      spec->kind = wild_index_literal;
+      len = strlen (name) + 1;
+    }
+  else
+    {
+      len = strcspn (name, "?*[\\");
+      if (name[len] == '*' && name[len + 1] == '\0')
+	spec->kind = wild_index_prefix;
+      else
+	spec->kind = wild_index_glob;
+    }
+
+  for (i = 0; i < len; i++)
+    {
+      struct wild_index_node **link = &node->child;
+
+      while (*link != NULL && (*link)->c != name[i])
+	link = &(*link)->sibling;
+      if (*link == NULL)
+	{
+	  *link = (struct wild_index_node *) xcalloc (1, sizeof (**link));
+	  (*link)->c = name[i];
+	}
+      node = *link;
+    }
+
+  node->specs = (size_t *) xrealloc (node->specs,
+				     (node->spec_count + 1)
+				     * sizeof (*node->specs));
+  node->specs[node->spec_count++] = wild_index.spec_count++;
+}
+
+/* Number the wild statements in the list starting at S, and add their
+   specs to the index.  */
+
+static void
+wild_index_add_statements (lang_statement_union_type *s)
+{
+  for (; s != NULL; s = s->header.next)
+    {
+      switch (s->header.type)
+	{
+	case lang_constructors_statement_enum:
+	  wild_index_add_statements (constructor_list.head);
+	  break;
+	case lang_output_section_statement_enum:
+	  wild_index_add_statements
+	    (s->output_section_statement.children.head);
+	  break;
+	case lang_group_statement_enum:
+	  wild_index_add_statements (s->group_statement.children.head);
+	  break;
+	case lang_wild_statement_enum:
+	  {
+	    lang_wild_statement_type *w = &s->wild_statement;
+	    struct wildcard_list *sec;
+
+	    w->wild_index = 0;
+	    if (w->section_list == NULL)
+	      break;
+	    w->wild_index = ++wild_index.stmt_count;
+	    for (sec = w->section_list; sec != NULL; sec = sec->next)
+	      wild_index_add_spec (sec, w->wild_index);
+	  }
+	  break;
+	default:
+	  break;
+	}
+    }
+}
+
+static int
+wild_index_compare_specs (const void *a, const void *b)
+{
+  size_t ia = *(const size_t *) a;
+  size_t ib = *(const size_t *) b;
+
+  return ia < ib ? -1 : ia > ib;
+}
+
+static int
+wild_index_compare_matches (const void *a, const void *b)
+{
+  const struct wild_index_match *ma = (const struct wild_index_match *) a;
+  const struct wild_index_match *mb = (const struct wild_index_match *) b;
+
+  if (ma->stmt != mb->stmt)
+    return ma->stmt < mb->stmt ? -1 : 1;
+  return ma->seq < mb->seq ? -1 : ma->seq > mb->seq;
+}
+
+/* Find the specs matching the sections of the I'th file of
+   wild_index.files, and attach them to the file.  This runs in a
+   worker thread, so on failure it just leaves the file without
+   matches.  */
+
+static void
+wild_index_file_matches (void *data ATTRIBUTE_UNUSED, size_t i)
+{
+  lang_input_statement_type *file = wild_index.files[i];
+  struct wild_index_file *fm;
+  struct wild_index_match *matches = NULL;
+  size_t count = 0, alloc = 0;
+  size_t *found = NULL;
+  size_t found_alloc = 0;
+  asection *s;
+
+  for (s = file->the_bfd->sections; s != NULL; s = s->next)
+    {
+      const char *name = bfd_section_name (s);
+      struct wild_index_node *node = &wild_index.root;
+      size_t nfound = 0;
+      size_t j;
+
+      /* Collect the specs along the path of NAME, including its
+	 terminating NUL.  */
+      for (j = 0; ; j++)
+	{
+	  if (nfound + node->spec_count > found_alloc)
+	    {
+	      size_t *n;
+
+	      found_alloc = (nfound + node->spec_count) * 2;
+	      n = (size_t *) realloc (found, found_alloc * sizeof (*found));
+	      if (n == NULL)
+		goto fail;
+	      found = n;
+	    }
+	  memcpy (found + nfound, node->specs,
+		  node->spec_count * sizeof (*found));
+	  nfound += node->spec_count;
+
+	  if (j > 0 && name[j - 1] == '\0')
+	    break;
+	  for (node = node->child; node != NULL; node = node->sibling)
+	    if (node->c == name[j])
+	      break;
+	  if (node == NULL)
+	    break;
+	}
+
+      if (nfound > 1)
+	qsort (found, nfound, sizeof (*found), wild_index_compare_specs);
+
+      for (j = 0; j < nfound; j++)
+	{
+	  struct wild_index_spec *spec = &wild_index.specs[found[j]];
+
+	  if (spec->kind == wild_index_glob
+	      && fnmatch (spec->sec->spec.name, name, 0) != 0)
+	    continue;
+
+	  if (count == alloc)
+	    {
+	      struct wild_index_match *n;
+
+	      alloc = alloc * 2 + 16;
+	      n = (struct wild_index_match *)
+		realloc (matches, alloc * sizeof (*matches));
+	      if (n == NULL)
+		goto fail;
+	      matches = n;
+	    }
+	  matches[count].section = s;
+	  matches[count].sec = spec->sec;
+	  matches[count].stmt = spec->stmt;
+	  matches[count].seq = count;
+	  count++;
+	}
+    }
+
+  fm = (struct wild_index_file *) malloc (sizeof (*fm));
+  if (fm == NULL)
+    goto fail;
+  qsort (matches, count, sizeof (*matches), wild_index_compare_matches);
+  fm->section_count = file->the_bfd->section_count;
+  fm->count = count;
+  fm->matches = matches;
+  file->wild_matches = fm;
+  free (found);
+  return;
+
+ fail:
+  free (matches);
+  free (found);
+}
+
+/* Build the wildcard index for the statements in the list starting at
+   S, and find the matching sections of every input file.  */
+
+static void
+build_wild_index (lang_statement_union_type *s)
+{
+  size_t count, i, nthreads;
+
+  memset (&wild_index, 0, sizeof (wild_index));
+  wild_index_add_statements (s);
+  if (wild_index.stmt_count == 0)
+    return;
+
+  count = 0;
+  LANG_FOR_EACH_INPUT_STATEMENT (f)
+    {
+      f->wild_matches = NULL;
+      if (f->the_bfd != NULL
+	  && !f->flags.just_syms
+	  && bfd_get_format (f->the_bfd) == bfd_object)
+	count++;
+    }
+
+  wild_index.files = (lang_input_statement_type **)
+    xmalloc (count * sizeof (*wild_index.files));
+  i = 0;
+  for (f = (lang_input_statement_type *) file_chain.head;
+       f != NULL;
+       f = f->next)
+    if (f->the_bfd != NULL
+	&& !f->flags.just_syms
+	&& bfd_get_format (f->the_bfd) == bfd_object)
+      wild_index.files[i++] = f;
+
+  /* Don't bother starting threads for a few files.  */
+  nthreads = bfd_get_max_threads ();
+  if (count < nthreads * WILD_INDEX_FILES_PER_THREAD)
+    for (i = 0; i < count; i++)
+      wild_index_file_matches (NULL, i);
+  else
+    bfd_parallel_for (count, wild_index_file_matches, NULL);
+}
+
+static void
+free_wild_index_node (struct wild_index_node *node)
+{
+  while (node != NULL)
+    {
+      struct wild_index_node *next = node->sibling;
+
+      free_wild_index_node (node->child);
+      free (node->specs);
+      free (node);
+      node = next;
+    }
+}
+
+/* Free the wildcard index, and stop walk_wild_section using it.  */
+
+static void
+free_wild_index (void)
+{
+  LANG_FOR_EACH_INPUT_STATEMENT (f)
+    if (f->wild_matches != NULL)
+      {
+	free (f->wild_matches->matches);
+	free (f->wild_matches);
+	f->wild_matches = NULL;
+      }
+  free_wild_index_node (wild_index.root.child);
+  free (wild_index.root.specs);
+  free (wild_index.specs);
+  free (wild_index.files);
+  memset (&wild_index, 0, sizeof (wild_index));
+}
+
+/* Walk the sections of FILE matching the wild statement PTR that were
+   found by build_wild_index.  */
+
+static void
+walk_wild_section_indexed (lang_wild_statement_type *ptr,
+			   lang_input_statement_type *file,
+			   callback_t callback,
+			   void *data)
+{
+  struct wild_index_file *fm = file->wild_matches;
+  size_t lo = 0, hi = fm->count;
+
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+
+      if (fm->matches[mid].stmt < ptr->wild_index)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+  for (; lo < fm->count && fm->matches[lo].stmt == ptr->wild_index; lo++)
+    walk_wild_consider_section (ptr, file, fm->matches[lo].section,
+				fm->matches[lo].sec, callback, data);
+}
+
 static void
 walk_wild_section (lang_wild_statement_type *ptr,
 		   lang_input_statement_type *file,
@@ -793,7 +1184,12 @@ walk_wild_section (lang_wild_statement_type *ptr,
   if (file->flags.just_syms)
     return;
 
-  (*ptr->walk_wild_section_handler) (ptr, file, callback, data);
+  if (ptr->wild_index != 0
+      && file->wild_matches != NULL
+      && file->wild_matches->section_count == file->the_bfd->section_count)
+    walk_wild_section_indexed (ptr, file, callback, data);
+  else
+    (*ptr->walk_wild_section_handler) (ptr, file, callback, data);
 }
 
 /* Returns TRUE when name1 is a wildcard spec that might match
@@ -3520,6 +3916,56 @@ init_opb (asection *s)
 
 /* Open all the input files.  */
 
+/* With --threads, the number of input files per thread whose symbols
+   are read ahead by prefetch_input_symbols.  */
+#define PREFETCH_FILES_PER_THREAD 16
+
+/* Open the plain input files in the run of input statements starting
+   at S, up to a limit, and have BFD read and swap in their symbols in
+   parallel.  load_symbols then adds them to the link one by one, in
+   the usual order.  Files that can't be opened here are left for
+   load_symbols to open and report.  */
+
+static void
+prefetch_input_symbols (lang_statement_union_type *s)
+{
+  size_t max = (size_t) bfd_get_max_threads () * PREFETCH_FILES_PER_THREAD;
+  size_t count = 0;
+  bfd **abfds;
+
+  if (bfd_get_max_threads () < 2
+      || link_info.lto_plugin_active
+      || bfd_get_flavour (link_info.output_bfd) != bfd_target_elf_flavour)
+    return;
+
+  abfds = (bfd **) xmalloc (max * sizeof (*abfds));
+  for (; s != NULL && count < max; s = s->header.next)
+    {
+      lang_input_statement_type *entry;
+
+      if (s->header.type != lang_input_statement_enum)
+	break;
+
+      entry = &s->input_statement;
+      if (!entry->flags.real
+	  || entry->flags.search_dirs
+	  || entry->flags.just_syms
+	  || entry->flags.loaded
+	  || entry->flags.missing_file
+	  || entry->the_bfd != NULL)
+	continue;
+
+      entry->target = current_target;
+      if (ldfile_try_open_bfd (entry->filename, entry)
+	  && bfd_check_format (entry->the_bfd, bfd_object)
+	  && bfd_get_flavour (entry->the_bfd) == bfd_target_elf_flavour)
+	abfds[count++] = entry->the_bfd;
+    }
+
+  bfd_elf_link_prefetch_symbols (abfds, count);
+  free (abfds);
+}
+
 enum open_bfd_mode
   {
     OPEN_BFD_NORMAL = 0,
@@ -3619,6 +4065,10 @@ open_input_bfds (lang_statement_union_type *s, enum open_bfd_mode mode)
 		  s->input_statement.flags.reload = TRUE;
 		}
 
+	      if ((mode & OPEN_BFD_RESCAN) == 0
+		  && s->input_statement.the_bfd == NULL)
+		prefetch_input_symbols (s);
+
 	      os_tail = lang_os_list.tail;
 	      lang_list_init (&add);
 
@@ -7998,8 +8448,10 @@ lang_process (void)
 
   /* Run through the contours of the script and attach input sections
      to the correct output sections.  */
+  build_wild_index (statement_list.head);
   lang_statement_iteration++;
   map_input_to_output_sections (statement_list.head, NULL, NULL);
+  free_wild_index ();
 
   /* Start at the statement immediately after the special abs_section
      output statement, so that it isn't reordered.  */
@@ -8139,6 +8591,7 @@ lang_add_wild (struct wildcard_spec *filespec,
     }
   new_stmt->section_list = section_list;
   new_stmt->keep_sections = keep_sections;
+  new_stmt->wild_index = 0;
   lang_list_init (&new_stmt->children);
   analyze_walk_wild_section_handler (new_stmt);
 }
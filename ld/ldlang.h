@@ -313,6 +313,10 @@ typedef struct lang_input_statement_struct
 
   const char *target;
 
+  /* The sections of this file matching each wild statement, found by
+     build_wild_index.  */
+  struct wild_index_file *wild_matches;
+
   struct lang_input_statement_flags flags;
 } lang_input_statement_type;
 
@@ -380,6 +384,9 @@ struct lang_wild_statement_struct
   struct wildcard_list *handler_data[4];
   lang_section_bst_type *tree;
   struct flag_info *section_flag_list;
+
+  /* The number of this statement in the wildcard index, or zero.  */
+  unsigned int wild_index;
 };
 
 typedef struct lang_address_statement_struct
@@ -154,6 +154,13 @@ enum option_values
   OPTION_NO_PRINT_MAP_DISCARDED,
   OPTION_NON_CONTIGUOUS_REGIONS,
   OPTION_NON_CONTIGUOUS_REGIONS_WARNINGS,
+  OPTION_THREADS,
+  OPTION_NO_THREADS,
+  OPTION_ICF,
+  OPTION_PRINT_ICF_SECTIONS,
+  OPTION_NO_PRINT_ICF_SECTIONS,
+  OPTION_MMAP_INPUTS,
+  OPTION_NO_MMAP_INPUTS,
 };
 
 /* The initial parser states.  */
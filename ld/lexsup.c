@@ -356,6 +356,14 @@ static const struct ld_option ld_options[] =
   { {"gc-keep-exported", no_argument, NULL, OPTION_GC_KEEP_EXPORTED},
     '\0', NULL, N_("Keep exported symbols when removing unused sections"),
     TWO_DASHES },
+  { {"icf", required_argument, NULL, OPTION_ICF},
+    '\0', N_("[none|all]"), N_("Fold identical code sections"),
+    TWO_DASHES },
+  { {"print-icf-sections", no_argument, NULL, OPTION_PRINT_ICF_SECTIONS},
+    '\0', NULL, N_("List folded sections on stderr"), TWO_DASHES },
+  { {"no-print-icf-sections", no_argument, NULL,
+     OPTION_NO_PRINT_ICF_SECTIONS},
+    '\0', NULL, N_("Do not list folded sections"), TWO_DASHES },
   { {"hash-size=<NUMBER>", required_argument, NULL, OPTION_HASH_SIZE},
     '\0', NULL, N_("Set default hash table size close to <NUMBER>"),
     TWO_DASHES },
@@ -570,6 +578,17 @@ static const struct ld_option ld_options[] =
   { {"no-print-map-discarded", no_argument, NULL, OPTION_NO_PRINT_MAP_DISCARDED},
     '\0', NULL, N_("Do not show discarded sections in map file output"),
     TWO_DASHES },
+  { {"threads", optional_argument, NULL, OPTION_THREADS},
+    '\0', N_("[=COUNT]"),
+    N_("Use up to COUNT threads [one per processor]"), TWO_DASHES },
+  { {"no-threads", no_argument, NULL, OPTION_NO_THREADS},
+    '\0', NULL, N_("Use a single thread (default)"), TWO_DASHES },
+  { {"mmap-inputs", no_argument, NULL, OPTION_MMAP_INPUTS},
+    '\0', NULL, N_("Map input section contents from the input files"),
+    TWO_DASHES },
+  { {"no-mmap-inputs", no_argument, NULL, OPTION_NO_MMAP_INPUTS},
+    '\0', NULL, N_("Read copies of input section contents (default)"),
+    TWO_DASHES },
 };
 
 #define OPTION_COUNT ARRAY_SIZE (ld_options)
@@ -923,6 +942,20 @@ parse_args (unsigned argc, char **argv)
 	case OPTION_GC_KEEP_EXPORTED:
 	  link_info.gc_keep_exported = TRUE;
 	  break;
+	case OPTION_ICF:
+	  if (strcmp (optarg, "all") == 0)
+	    link_info.icf = TRUE;
+	  else if (strcmp (optarg, "none") == 0)
+	    link_info.icf = FALSE;
+	  else
+	    einfo (_("%F%P: invalid argument to option \"--icf\"\n"));
+	  break;
+	case OPTION_PRINT_ICF_SECTIONS:
+	  link_info.print_icf_sections = TRUE;
+	  break;
+	case OPTION_NO_PRINT_ICF_SECTIONS:
+	  link_info.print_icf_sections = FALSE;
+	  break;
 	case OPTION_HELP:
 	  help ();
 	  xexit (0);
@@ -1631,6 +1664,32 @@ parse_args (unsigned argc, char **argv)
 	case OPTION_PRINT_MAP_DISCARDED:
 	  config.print_map_discarded = TRUE;
 	  break;
+
+	case OPTION_THREADS:
+	  if (optarg == NULL)
+	    bfd_set_max_threads (0);
+	  else
+	    {
+	      char *end;
+	      unsigned long count = strtoul (optarg, &end, 0);
+
+	      if (*end != '\0' || count == 0 || (unsigned int) count != count)
+		einfo (_("%F%P: invalid thread count `%s'\n"), optarg);
+	      bfd_set_max_threads (count);
+	    }
+	  break;
+
+	case OPTION_NO_THREADS:
+	  bfd_set_max_threads (1);
+	  break;
+
+	case OPTION_MMAP_INPUTS:
+	  config.mmap_inputs = TRUE;
+	  break;
+
+	case OPTION_NO_MMAP_INPUTS:
+	  config.mmap_inputs = FALSE;
+	  break;
 	}
     }
 
@@ -0,0 +1,23 @@
+	.text
+	.globl	_start
+	.p2align 4
+_start:
+	.fill	16, 1, 0
+
+	.section .text.f1,"ax",%progbits
+	.globl	f1
+	.p2align 4
+f1:
+	.fill	16, 1, 1
+
+	.section .text.f2,"ax",%progbits
+	.globl	f2
+	.p2align 4
+f2:
+	.fill	16, 1, 1
+
+	.section .text.f3,"ax",%progbits
+	.globl	f3
+	.p2align 4
+f3:
+	.fill	16, 1, 3
@@ -0,0 +1,33 @@
+	.text
+	.globl	_start
+	.p2align 4
+_start:
+	.fill	16, 1, 0
+
+	.section .text.even1,"ax",%progbits
+	.globl	even1
+	.p2align 4
+even1:
+	.dc.a	odd1
+	.fill	16, 1, 1
+
+	.section .text.odd1,"ax",%progbits
+	.globl	odd1
+	.p2align 4
+odd1:
+	.dc.a	even1
+	.fill	16, 1, 2
+
+	.section .text.even2,"ax",%progbits
+	.globl	even2
+	.p2align 4
+even2:
+	.dc.a	odd2
+	.fill	16, 1, 1
+
+	.section .text.odd2,"ax",%progbits
+	.globl	odd2
+	.p2align 4
+odd2:
+	.dc.a	even2
+	.fill	16, 1, 2
@@ -0,0 +1,31 @@
+	.text
+	.globl	_start
+	.p2align 4
+_start:
+	.fill	16, 1, 0
+
+	.section .text.t1,"ax",%progbits
+	.globl	t1
+	.p2align 4
+t1:
+	.fill	16, 1, 1
+
+	.section .text.t2,"ax",%progbits
+	.globl	t2
+	.p2align 4
+t2:
+	.fill	16, 1, 2
+
+	.section .text.r1,"ax",%progbits
+	.globl	r1
+	.p2align 4
+r1:
+	.dc.a	t1
+	.fill	16, 1, 3
+
+	.section .text.r2,"ax",%progbits
+	.globl	r2
+	.p2align 4
+r2:
+	.dc.a	t2
+	.fill	16, 1, 3
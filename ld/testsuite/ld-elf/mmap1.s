@@ -0,0 +1,16 @@
+	.text
+	.globl	_start
+	.type	_start, %function
+_start:
+	.cfi_startproc
+	.dc.a	str1
+	.dc.a	str2
+	.dc.a	mmap2
+	.dc.a	mmap3
+	.cfi_endproc
+
+	.section .rodata.str1.1,"aMS",%progbits,1
+str1:
+	.string	"foo"
+str2:
+	.string	"bar"
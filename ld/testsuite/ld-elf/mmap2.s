@@ -0,0 +1,14 @@
+	.text
+	.globl	mmap2
+	.type	mmap2, %function
+mmap2:
+	.cfi_startproc
+	.dc.a	str3
+	.dc.a	str4
+	.cfi_endproc
+
+	.section .rodata.str1.1,"aMS",%progbits,1
+str3:
+	.string	"foobar"
+str4:
+	.string	"baz"
@@ -0,0 +1,14 @@
+	.text
+	.globl	mmap3
+	.type	mmap3, %function
+mmap3:
+	.cfi_startproc
+	.dc.a	str5
+	.dc.a	str6
+	.cfi_endproc
+
+	.section .rodata.str1.1,"aMS",%progbits,1
+str5:
+	.string	"bar"
+str6:
+	.string	"bazbaz"
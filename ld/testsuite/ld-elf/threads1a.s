@@ -0,0 +1,7 @@
+	.globl _start
+	.weak baz
+	.data
+_start:
+	.dc.a foo
+	.dc.a bar
+	.dc.a baz
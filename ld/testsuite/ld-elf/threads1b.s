@@ -0,0 +1,4 @@
+	.globl foo
+	.weak bar
+	foo = 0x42
+	bar = 0x5678
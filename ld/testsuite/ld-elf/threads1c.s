@@ -0,0 +1,4 @@
+	.globl bar
+	.globl baz
+	bar = 0x1234
+	baz = 0x99
@@ -0,0 +1,36 @@
+	.text
+	.globl	_start
+	.type	_start, %function
+_start:
+	.globl	func_a
+	.type	func_a, %function
+func_a:
+	.dc.a	func_b
+.Lfunc_a:
+	.dc.a	var_c
+
+	.data
+	.globl	var_a
+var_a:
+	.dc.a	func_a
+.Lvar_a:
+	.dc.a	0
+
+	.section .debug_info,"",%progbits
+	.dc.a	func_a
+	.dc.a	.Lfunc_a
+	.dc.a	var_a
+	.dc.a	.Lvar_a + 4
+	.dc.a	func_b
+	.dc.a	var_c - 8
+	.4byte	.Lstr_a
+
+	.section .debug_line,"",%progbits
+	.dc.a	func_a
+	.dc.a	.Lfunc_a
+	.dc.a	func_c + 2
+
+	.section .debug_str,"MS",%progbits,1
+.Lstr_a:
+	.string	"func_a"
+	.string	"var_a"
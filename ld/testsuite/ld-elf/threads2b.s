@@ -0,0 +1,33 @@
+	.text
+	.globl	func_b
+	.type	func_b, %function
+func_b:
+	.dc.a	func_c
+.Lfunc_b:
+	.dc.a	var_a
+
+	.data
+	.globl	var_b
+var_b:
+	.dc.a	func_b
+.Lvar_b:
+	.dc.a	0
+
+	.section .debug_info,"",%progbits
+	.dc.a	func_b
+	.dc.a	.Lfunc_b
+	.dc.a	var_b
+	.dc.a	.Lvar_b + 4
+	.dc.a	func_c
+	.dc.a	var_a - 8
+	.4byte	.Lstr_b
+
+	.section .debug_line,"",%progbits
+	.dc.a	func_b
+	.dc.a	.Lfunc_b
+	.dc.a	func_a + 2
+
+	.section .debug_str,"MS",%progbits,1
+.Lstr_b:
+	.string	"func_b"
+	.string	"var_b"
@@ -0,0 +1,33 @@
+	.text
+	.globl	func_c
+	.type	func_c, %function
+func_c:
+	.dc.a	func_a
+.Lfunc_c:
+	.dc.a	var_b
+
+	.data
+	.globl	var_c
+var_c:
+	.dc.a	func_c
+.Lvar_c:
+	.dc.a	0
+
+	.section .debug_info,"",%progbits
+	.dc.a	func_c
+	.dc.a	.Lfunc_c
+	.dc.a	var_c
+	.dc.a	.Lvar_c + 4
+	.dc.a	func_a
+	.dc.a	var_b - 8
+	.4byte	.Lstr_c
+
+	.section .debug_line,"",%progbits
+	.dc.a	func_c
+	.dc.a	.Lfunc_c
+	.dc.a	func_b + 2
+
+	.section .debug_str,"MS",%progbits,1
+.Lstr_c:
+	.string	"func_c"
+	.string	"var_c"